@@ -102,6 +102,85 @@ extern void mstats (char *);
 #define M_MMAP_THRESHOLD    -3 
 #define M_MMAP_MAX          -4
 
+/* Fixed-size object pools. Objects come from a caller-supplied
+   buffer of count * MALLPOOL_OBJSIZE(size) bytes, or from a single
+   malloc'd block when buf is NULL.  */
+
+struct mallpool {
+  char *base;       /* object storage */
+  size_t size;      /* distance between objects */
+  size_t count;     /* number of objects */
+  size_t head;      /* free list: index + 1 of first free object */
+  size_t nfree;     /* number of free objects */
+  size_t min_free;  /* fewest free objects seen */
+  int flags;
+};
+
+#define MALLPOOL_ATOMIC	0x1	/* lock-free alloc/free from any thread */
+
+#define MALLPOOL_OBJSIZE(size) \
+  ((size) < sizeof (size_t) ? sizeof (size_t) : (size))
+
+extern int mallpool_init (struct mallpool *, size_t, size_t, void *, int);
+extern void mallpool_destroy (struct mallpool *);
+extern void *mallpool_alloc (struct mallpool *);
+extern void mallpool_free (struct mallpool *, void *);
+extern struct mallinfo mallpool_info (struct mallpool *);
+
+/* Bump-pointer arenas. Space comes from a caller-supplied buffer, or
+   a malloc'd block of the initial size when buf is NULL. When grow is
+   non-zero, full arenas add malloc'd blocks of at least that size.
+   Individual objects are never freed; release the arena back to a
+   mark or reset it instead.  */
+
+struct mallarena {
+  char *cur;        /* next free byte */
+  char *end;        /* end of the current block */
+  void *block;      /* current grown block, NULL for the initial region */
+  char *base;       /* initial region */
+  char *base_end;
+  size_t grow;      /* minimum size of grown blocks */
+  int flags;
+};
+
+struct mallarena_mark {
+  void *block;
+  char *cur;
+};
+
+extern int mallarena_init (struct mallarena *, void *, size_t, size_t);
+extern void mallarena_destroy (struct mallarena *);
+extern void *mallarena_alloc (struct mallarena *, size_t);
+extern void *mallarena_alloc_aligned (struct mallarena *, size_t, size_t);
+extern struct mallarena_mark mallarena_mark (struct mallarena *);
+extern void mallarena_release (struct mallarena *, struct mallarena_mark);
+extern void mallarena_reset (struct mallarena *);
+
+/* Heap usage counters, maintained by nano-malloc when built with
+   newlib-nano-malloc-stats. Sizes include the chunk header. Each
+   field is read atomically, but the set is not one consistent
+   snapshot while other threads are allocating.  */
+
+#define MALLSTATS_CLASSES (sizeof (size_t) * 8)
+
+struct mallstats {
+  size_t in_use;        /* bytes in allocated chunks */
+  size_t max_in_use;    /* high-water mark of in_use */
+  size_t arena;         /* bytes obtained from sbrk */
+  size_t largest_free;  /* largest chunk in the free pool */
+  size_t sbrk_calls;    /* number of sbrk requests */
+  size_t failed;        /* allocations which returned NULL */
+  size_t count[MALLSTATS_CLASSES]; /* chunks of 2**n to 2**(n+1)-1 bytes */
+};
+
+/* Allocation hooks receive the pointer, the requested (or usable,
+   for free) size and the caller's return address. Hooks must not
+   allocate memory.  */
+typedef void (*mallstats_hook_t) (void *, size_t, void *);
+
+extern void mallstats (struct mallstats *);
+extern void mallstats_set_hooks (mallstats_hook_t, mallstats_hook_t);
+
 #ifndef __CYGWIN__
 /* Some systems provide this, so do too for compatibility.  */
 extern void cfree (void *);
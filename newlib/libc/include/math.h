@@ -37,6 +37,7 @@ SUCH DAMAGE.
 
 #include <sys/cdefs.h>
 #include <ieeefp.h>
+#include <sys/_types.h>
 #include "_ansi.h"
 
 _BEGIN_STD_C
@@ -623,6 +624,53 @@ extern long double pow10l (long double);
 #endif
 #endif /* __GNU_VISIBLE */
 
+/* Array versions, computing out[i] = f(in[i]) for i < n.  The output
+   array may be the same as an input array.  */
+#if __MISC_VISIBLE
+extern void vexp (double *, const double *, __size_t);
+extern void vlog (double *, const double *, __size_t);
+extern void vpow (double *, const double *, const double *, __size_t);
+extern void vsin (double *, const double *, __size_t);
+extern void vcos (double *, const double *, __size_t);
+extern void vsincos (double *, double *, const double *, __size_t);
+extern void vexpf (float *, const float *, __size_t);
+extern void vlogf (float *, const float *, __size_t);
+extern void vpowf (float *, const float *, const float *, __size_t);
+extern void vsinf (float *, const float *, __size_t);
+extern void vcosf (float *, const float *, __size_t);
+extern void vsincosf (float *, float *, const float *, __size_t);
+
+/* Entry points which never set errno, whatever the library was built
+   with, and report errors through the exception flags alone.  Special
+   cases are handled out of line, so only the kernel sits on the
+   common path.  */
+extern double __fast_exp (double);
+extern double __fast_exp2 (double);
+extern double __fast_log (double);
+extern double __fast_log2 (double);
+extern double __fast_log10 (double);
+extern double __fast_log1p (double);
+extern double __fast_expm1 (double);
+extern double __fast_pow (double, double);
+extern double __fast_sin (double);
+extern double __fast_cos (double);
+extern double __fast_tan (double);
+extern double __fast_sinh (double);
+extern double __fast_cosh (double);
+extern double __fast_tanh (double);
+extern double __fast_asin (double);
+extern double __fast_acos (double);
+extern double __fast_atan (double);
+extern double __fast_atan2 (double, double);
+extern float __fast_expf (float);
+extern float __fast_exp2f (float);
+extern float __fast_logf (float);
+extern float __fast_log2f (float);
+extern float __fast_powf (float, float);
+extern float __fast_sinf (float);
+extern float __fast_cosf (float);
+#endif /* __MISC_VISIBLE */
+
 #if __MISC_VISIBLE || __XSI_VISIBLE
 extern NEWLIB_THREAD_LOCAL int signgam;
 #endif /* __MISC_VISIBLE || __XSI_VISIBLE */
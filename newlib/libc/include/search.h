@@ -61,6 +61,7 @@ typedef enum {
 typedef struct node {
 	char         *key;
 	struct node  *llink, *rlink;
+	signed char   balance;	/* AVL: height(rlink) - height(llink) */
 } node_t;
 #endif
 
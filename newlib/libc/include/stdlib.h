@@ -235,6 +235,8 @@ char *	__utoa (unsigned, char *, int);
 #if __MISC_VISIBLE
 char *	itoa (int, char *, int);
 char *	utoa (unsigned, char *, int);
+int	dtoa_shortest (double, char *, size_t);
+int	ftoa_shortest (float, char *, size_t);
 #endif
 #if __POSIX_VISIBLE
 int	rand_r (unsigned *__seed);
@@ -9,6 +9,6 @@
    http://www.opensource.org/licenses.
 */
 
-#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__) && !defined(__riscv_vector)
 #include "../../string/memmove.c"
 #endif
@@ -9,6 +9,10 @@
    http://www.opensource.org/licenses.
 */
 
+#if defined(__riscv_vector)
+//strlen defined in strlen.S
+#else
+
 #include <string.h>
 #include <stdint.h>
 
@@ -51,3 +55,4 @@ size_t strlen(const char *str)
   return ret + 7 - sl;
 #endif /* not PREFER_SIZE_OVER_SPEED */
 }
+#endif
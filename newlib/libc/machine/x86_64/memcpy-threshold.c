@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if defined(__OPTIMIZE_SIZE__) || defined(PREFER_SIZE_OVER_SPEED)
+/* The size-optimized memcpy.S and memset.S don't use these */
+#else
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Size thresholds for memcpy, memmove and memset in memcpy.S and
+ * memset.S. Copies of at least __x86_64_non_temporal_threshold bytes
+ * use non-temporal stores. Below that, copies of at least
+ * __x86_64_rep_movsb_threshold bytes use rep movsb/stosb instead of
+ * the vector loop, but only on processors with ERMS, where those
+ * instructions run at full speed.
+ *
+ * Applications may set either threshold before the first large copy;
+ * a non-temporal threshold of zero is replaced by 3/4 of the largest
+ * data cache. __x86_64_memcpy_features is filled in on first use and
+ * records whether ERMS is present.
+ */
+
+#define REP_MOVSB_THRESHOLD		2048
+#define NON_TEMPORAL_THRESHOLD		(768 * 1024)
+
+/* Bits in __x86_64_memcpy_features, also tested in memcpy.S and memset.S */
+#define X86_64_MEMCPY_INIT		1
+#define X86_64_MEMCPY_ERMS		2
+
+size_t __x86_64_rep_movsb_threshold = REP_MOVSB_THRESHOLD;
+size_t __x86_64_non_temporal_threshold;
+unsigned int __x86_64_memcpy_features;
+
+void
+__x86_64_memcpy_init(void);
+
+static inline void
+cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+    __asm__ volatile ("cpuid"
+                      : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+                      : "a" (leaf), "c" (subleaf));
+}
+
+/*
+ * Walk the deterministic cache parameter leaf (4 on Intel,
+ * 0x8000001d on AMD) and return the size of the largest data or
+ * unified cache
+ */
+static size_t
+cache_size(uint32_t leaf)
+{
+    uint32_t    regs[4];
+    uint32_t    i;
+    size_t      largest = 0;
+
+    for (i = 0; i < 16; i++) {
+        uint32_t type;
+        size_t   size;
+
+        cpuid(leaf, i, regs);
+        type = regs[0] & 0x1f;
+        if (type == 0)
+            break;
+        if (type == 2)          /* instruction cache */
+            continue;
+        size = (size_t) ((regs[1] >> 22) + 1) *         /* ways */
+            (size_t) (((regs[1] >> 12) & 0x3ff) + 1) *  /* partitions */
+            (size_t) ((regs[1] & 0xfff) + 1) *          /* line size */
+            (size_t) (regs[2] + 1);                     /* sets */
+        if (size > largest)
+            largest = size;
+    }
+    return largest;
+}
+
+void
+__x86_64_memcpy_init(void)
+{
+    uint32_t    regs[4];
+    uint32_t    max_leaf, max_ext_leaf;
+    size_t      size = 0;
+
+    cpuid(0, 0, regs);
+    max_leaf = regs[0];
+    cpuid(0x80000000, 0, regs);
+    max_ext_leaf = regs[0];
+
+    if (max_leaf >= 4)
+        size = cache_size(4);
+    if (size == 0 && max_ext_leaf >= 0x8000001d)
+        size = cache_size(0x8000001d);
+
+    /* Without ERMS, rep movsb is slower than the vector loop */
+    if (max_leaf >= 7)
+        cpuid(7, 0, regs);
+    else
+        regs[1] = 0;
+
+    if (__x86_64_non_temporal_threshold == 0) {
+        if (size)
+            __x86_64_non_temporal_threshold = size / 4 * 3;
+        else
+            __x86_64_non_temporal_threshold = NON_TEMPORAL_THRESHOLD;
+    }
+
+    __x86_64_memcpy_features = X86_64_MEMCPY_INIT |
+        ((regs[1] & (1 << 9)) ? X86_64_MEMCPY_ERMS : 0);
+}
+
+#endif
@@ -37,6 +37,7 @@ is preserved.
 #define rdi REG(rdi)
 #define rbp REG(rbp)
 #define rsp REG(rsp)
+#define rip REG(rip)
 
 #define r8  REG(r8)
 #define r9  REG(r9)
@@ -98,6 +99,31 @@ is preserved.
 #define xmm5 REG(xmm5)
 #define xmm6 REG(xmm6)
 #define xmm7 REG(xmm7)
+#define xmm8 REG(xmm8)
+#define xmm9 REG(xmm9)
+#define xmm10 REG(xmm10)
+#define xmm11 REG(xmm11)
+#define xmm12 REG(xmm12)
+#define xmm13 REG(xmm13)
+#define xmm14 REG(xmm14)
+#define xmm15 REG(xmm15)
+
+#define ymm0 REG(ymm0)
+#define ymm1 REG(ymm1)
+#define ymm2 REG(ymm2)
+#define ymm3 REG(ymm3)
+#define ymm4 REG(ymm4)
+#define ymm5 REG(ymm5)
+#define ymm6 REG(ymm6)
+#define ymm7 REG(ymm7)
+
+#define r8d  REG(r8d)
+#define r9d  REG(r9d)
+#define r10d REG(r10d)
+#define r11d REG(r11d)
+
+#define r8w  REG(r8w)
+#define r9w  REG(r9w)
 
 #define cr0 REG(cr0)
 #define cr1 REG(cr1)
@@ -105,6 +131,65 @@ is preserved.
 #define cr3 REG(cr3)
 #define cr4 REG(cr4)
 
+/*
+ * Vector operations for the string functions. These use 32-byte AVX2
+ * registers when the target flags enable AVX2 and otherwise 16-byte
+ * SSE2 registers, which every x86_64 processor has. Two-operand forms
+ * modify 'dst' in place in both cases. XMOVU always moves 16 bytes,
+ * using the VEX encoding in AVX2 code to avoid SSE/AVX transitions.
+ */
+#ifdef __AVX2__
+#define VEC_SIZE	32
+#define VEC_MASK	0xffffffff
+#define V0		ymm0
+#define V1		ymm1
+#define V2		ymm2
+#define V3		ymm3
+#define V4		ymm4
+#define V5		ymm5
+#define V6		ymm6
+#define V7		ymm7
+#define VMOVA(src, dst)		vmovdqa src, dst
+#define VMOVU(src, dst)		vmovdqu src, dst
+#define VMOVNT(src, dst)	vmovntdq src, dst
+#define XMOVU(src, dst)		vmovdqu src, dst
+#define VPCMPEQB(src, dst)	vpcmpeqb src, dst, dst
+#define VPANDN(src, dst)	vpandn src, dst, dst
+#define VPOR(src, dst)		vpor src, dst, dst
+#define VPXOR(src, dst)		vpxor src, dst, dst
+#define VPMOVMSKB(src, dst)	vpmovmskb src, dst
+#define VBROADCASTB(src, x, dst) \
+	vmovd src, x; \
+	vpbroadcastb x, dst
+#define VZEROUPPER		vzeroupper
+#else
+#define VEC_SIZE	16
+#define VEC_MASK	0xffff
+#define V0		xmm0
+#define V1		xmm1
+#define V2		xmm2
+#define V3		xmm3
+#define V4		xmm4
+#define V5		xmm5
+#define V6		xmm6
+#define V7		xmm7
+#define VMOVA(src, dst)		movdqa src, dst
+#define VMOVU(src, dst)		movdqu src, dst
+#define VMOVNT(src, dst)	movntdq src, dst
+#define XMOVU(src, dst)		movdqu src, dst
+#define VPCMPEQB(src, dst)	pcmpeqb src, dst
+#define VPANDN(src, dst)	pandn src, dst
+#define VPOR(src, dst)		por src, dst
+#define VPXOR(src, dst)		pxor src, dst
+#define VPMOVMSKB(src, dst)	pmovmskb src, dst
+#define VBROADCASTB(src, x, dst) \
+	movd src, x; \
+	punpcklbw x, x; \
+	punpcklwd x, x; \
+	pshufd $0, x, x
+#define VZEROUPPER
+#endif
+
 #ifdef _I386MACH_NEED_SOTYPE_FUNCTION
 #define SOTYPE_FUNCTION(sym) .type SYM(sym),@function
 #else
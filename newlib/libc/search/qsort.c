@@ -65,10 +65,8 @@ PORTABILITY
 #include <_ansi.h>
 #include <sys/cdefs.h>
 #include <stdlib.h>
-
-#ifndef __GNUC__
-#define inline
-#endif
+#include <stdint.h>
+#include <stdbool.h>
 
 #if defined(I_AM_QSORT_R)
 typedef int		 cmp_t(void *, const void *, const void *);
@@ -77,89 +75,384 @@ typedef int		 cmp_t(const void *, const void *, void *);
 #else
 typedef int		 cmp_t(const void *, const void *);
 #endif
-static inline char	*med3 (char *, char *, char *, cmp_t *, void *);
-static inline void	 swapfunc (char *, char *, int, int);
 
-#define min(a, b)	(a) < (b) ? a : b
+#if defined(I_AM_QSORT_R)
+#define	CMP(t, x, y) (cmp((t), (x), (y)))
+#elif defined(I_AM_GNU_QSORT_R)
+#define	CMP(t, x, y) (cmp((x), (y), (t)))
+#else
+#define	CMP(t, x, y) (cmp((x), (y)))
+#endif
+
+/*
+ * Pattern-defeating quicksort (Orson Peters, "pdqsort"), an introsort
+ * variant:
+ *
+ *  - Median-of-three pivots, or the median of three medians for
+ *    larger ranges.
+ *
+ *  - When the pivot equals the element just before the range, every
+ *    element equal to it is gathered on the left and never looked at
+ *    again, so inputs with few distinct values sort in linear time.
+ *
+ *  - A partition which leaves less than 1/8 of the elements on one
+ *    side counts as bad. After log2(n) bad partitions the range is
+ *    heapsorted, bounding the worst case at O(n log n); before that,
+ *    a few elements are swapped to break up whatever pattern caused it.
+ *
+ *  - A partition which needed no swaps suggests the input was
+ *    already sorted; both sides get an insertion sort which gives up
+ *    after a few moves.
+ *
+ * The larger side of each partition is pushed on a fixed stack and the
+ * smaller one sorted next, so the stack never holds more than log2(n)
+ * entries and the function doesn't recurse.
+ */
+
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+#define INSERTION_SORT_THRESHOLD	8
+#else
+#define INSERTION_SORT_THRESHOLD	16
+#endif
+#define NINTHER_THRESHOLD		128
+#define PARTIAL_INSERTION_SORT_LIMIT	8
 
 /*
- * Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Elements are swapped in the widest units that both the base address
+ * and the element size are aligned to
  */
-#define swapcode(TYPE, parmi, parmj, n) { 		\
-	long i = (n) / sizeof (TYPE); 			\
-	TYPE *pi = (TYPE *) (parmi); 		\
-	TYPE *pj = (TYPE *) (parmj); 		\
-	do { 						\
-		TYPE	t = *pi;		\
+#define SWAP_U64	0
+#define SWAP_U32	1
+#define SWAP_BYTES	2
+
+static __always_inline int
+swap_type(const void *a, size_t es)
+{
+	uintptr_t bits = (uintptr_t) a | es;
+
+	if ((bits & (sizeof(uint64_t) - 1)) == 0)
+		return SWAP_U64;
+	if ((bits & (sizeof(uint32_t) - 1)) == 0)
+		return SWAP_U32;
+	return SWAP_BYTES;
+}
+
+#define swapcode(TYPE, parmi, parmj, n) {		\
+	size_t i = (n) / sizeof (TYPE);			\
+	TYPE *pi = (TYPE *) (parmi);			\
+	TYPE *pj = (TYPE *) (parmj);			\
+	do {						\
+		TYPE	t = *pi;			\
 		*pi++ = *pj;				\
 		*pj++ = t;				\
-        } while (--i > 0);				\
+	} while (--i > 0);				\
 }
 
-#define SWAPINIT(a, es) swaptype = ((char *)a - (char *)0) % sizeof(long) || \
-	es % sizeof(long) ? 2 : es == sizeof(long)? 0 : 1;
-
-static inline void
-swapfunc (char *a,
-	char *b,
-	int n,
-	int swaptype)
+static __always_inline void
+swap(char *a, char *b, size_t es, int swaptype)
 {
-	if(swaptype <= 1)
-		swapcode(long, a, b, n)
+	if (swaptype == SWAP_U64)
+		swapcode(uint64_t, a, b, es)
+	else if (swaptype == SWAP_U32)
+		swapcode(uint32_t, a, b, es)
 	else
-		swapcode(char, a, b, n)
+		swapcode(char, a, b, es)
 }
 
-#define swap(a, b)					\
-	if (swaptype == 0) {				\
-		long t = *(long *)(a);			\
-		*(long *)(a) = *(long *)(b);		\
-		*(long *)(b) = t;			\
-	} else						\
-		swapfunc(a, b, es, swaptype)
+/* Order two elements */
+static __always_inline void
+sort2(char *a, char *b, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	if (CMP(thunk, b, a) < 0)
+		swap(a, b, es, swaptype);
+}
 
-#define vecswap(a, b, n) 	if ((n) > 0) swapfunc(a, b, n, swaptype)
+/* Order three elements, leaving the median in b */
+static __always_inline void
+sort3(char *a, char *b, char *c, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	sort2(a, b, es, swaptype, cmp, thunk);
+	sort2(b, c, es, swaptype, cmp, thunk);
+	sort2(a, b, es, swaptype, cmp, thunk);
+}
 
-#if defined(I_AM_QSORT_R)
-#define	CMP(t, x, y) (cmp((t), (x), (y)))
-#elif defined(I_AM_GNU_QSORT_R)
-#define	CMP(t, x, y) (cmp((x), (y), (t)))
-#else
-#define	CMP(t, x, y) (cmp((x), (y)))
-#endif
+static __always_inline void
+insertion_sort(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	char *end = a + n * es;
+	char *pm, *pl;
 
-static inline char *
-med3 (char *a,
-	char *b,
-	char *c,
-	cmp_t *cmp,
-	void *thunk
-#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
-__unused
-#endif
-)
+	for (pm = a + es; pm < end; pm += es)
+		for (pl = pm; pl > a && CMP(thunk, pl - es, pl) > 0; pl -= es)
+			swap(pl, pl - es, es, swaptype);
+}
+
+/*
+ * Insertion sort which gives up once it has moved elements more than
+ * PARTIAL_INSERTION_SORT_LIMIT places in total. Returns whether the
+ * range is now sorted.
+ */
+static __always_inline bool
+partial_insertion_sort(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	char *end = a + n * es;
+	char *pm, *pl;
+	size_t moves = 0;
+
+	for (pm = a + es; pm < end; pm += es) {
+		for (pl = pm; pl > a && CMP(thunk, pl - es, pl) > 0; pl -= es) {
+			swap(pl, pl - es, es, swaptype);
+			moves++;
+		}
+		if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+			return pm + es == end;
+	}
+	return true;
+}
+
+static __always_inline void
+sift_down(char *a, size_t root, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
 {
-	return CMP(thunk, a, b) < 0 ?
-	       (CMP(thunk, b, c) < 0 ? b : (CMP(thunk, a, c) < 0 ? c : a ))
-              :(CMP(thunk, b, c) > 0 ? b : (CMP(thunk, a, c) < 0 ? a : c ));
+	size_t child;
+
+	while ((child = 2 * root + 1) < n) {
+		if (child + 1 < n && CMP(thunk, a + child * es, a + (child + 1) * es) < 0)
+			child++;
+		if (CMP(thunk, a + root * es, a + child * es) >= 0)
+			return;
+		swap(a + root * es, a + child * es, es, swaptype);
+		root = child;
+	}
+}
+
+static __always_inline void
+heap_sort(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	size_t i;
+
+	for (i = n / 2; i > 0; i--)
+		sift_down(a, i - 1, n, es, swaptype, cmp, thunk);
+	for (i = n - 1; i > 0; i--) {
+		swap(a, a + i * es, es, swaptype);
+		sift_down(a, 0, i, es, swaptype, cmp, thunk);
+	}
 }
 
 /*
- * Classical function call recursion wastes a lot of stack space. Each
- * recursion level requires a full stack frame comprising all local variables
- * and additional space as dictated by the processor calling convention.
- *
- * This implementation instead stores the variables that are unique for each
- * recursion level in a parameter stack array, and uses iteration to emulate
- * recursion. Function call recursion is not used until the array is full.
- *
- * To ensure the stack consumption isn't worsened by this design, the size of
- * the parameter stack array is chosen to be similar to the stack frame
- * excluding the array. Each function call recursion level can handle this
- * number of iterative recursion levels.
+ * Partition around the pivot in a[0]. Elements less than the pivot
+ * end up to its left, the rest to its right. Returns the final pivot
+ * position and sets *already when no elements needed swapping.
+ */
+static __always_inline char *
+partition_right(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk,
+		bool *already)
+{
+	char *end = a + n * es;
+	char *first = a + es;
+	char *last = end;
+
+	while (first < last && CMP(thunk, first, a) < 0)
+		first += es;
+	do
+		last -= es;
+	while (last >= first && CMP(thunk, last, a) >= 0);
+
+	*already = first >= last;
+
+	/*
+	 * Each swap leaves an element on each side which stops the
+	 * other scan, but only if the comparison function is
+	 * consistent, so keep the scans inside the range anyway
+	 */
+	while (first < last) {
+		swap(first, last, es, swaptype);
+		do
+			first += es;
+		while (first < end && CMP(thunk, first, a) < 0);
+		do
+			last -= es;
+		while (last > a && CMP(thunk, last, a) >= 0);
+	}
+
+	last = first - es;
+	if (last != a)
+		swap(a, last, es, swaptype);
+	return last;
+}
+
+/*
+ * Partition around the pivot in a[0], putting elements equal to it on
+ * the left. Used when the pivot equals the element before the range,
+ * which means nothing in the range is smaller and the left side is
+ * all equal and needs no further sorting.
  */
-#define PARAMETER_STACK_LEVELS 8u
+static __always_inline char *
+partition_left(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	char *end = a + n * es;
+	char *first = a;
+	char *last = end;
+
+	do
+		last -= es;
+	while (last > a && CMP(thunk, a, last) < 0);
+
+	do
+		first += es;
+	while (first < last && CMP(thunk, a, first) >= 0);
+
+	/* Bounded scans, as in partition_right */
+	while (first < last) {
+		swap(first, last, es, swaptype);
+		do
+			last -= es;
+		while (last > a && CMP(thunk, a, last) < 0);
+		do
+			first += es;
+		while (first < end && CMP(thunk, a, first) >= 0);
+	}
+
+	if (last != a)
+		swap(a, last, es, swaptype);
+	return last;
+}
+
+/* Swap a few elements around to break up patterns which lead to bad pivots */
+static __always_inline void
+break_patterns(char *a, size_t n, size_t es, int swaptype)
+{
+	size_t q = n / 4;
+	char *end = a + n * es;
+
+	swap(a, a + q * es, es, swaptype);
+	swap(end - es, end - (q + 1) * es, es, swaptype);
+	if (n > NINTHER_THRESHOLD) {
+		swap(a + es, a + (q + 1) * es, es, swaptype);
+		swap(a + 2 * es, a + (q + 2) * es, es, swaptype);
+		swap(end - 2 * es, end - (q + 2) * es, es, swaptype);
+		swap(end - 3 * es, end - (q + 3) * es, es, swaptype);
+	}
+}
+
+struct sort_range {
+	char	*a;
+	size_t	n;
+	int	bad_allowed;
+	bool	leftmost;
+};
+
+static __always_inline void
+sort_engine(char *a, size_t n, size_t es, int swaptype, cmp_t *cmp, void *thunk)
+{
+	struct sort_range stack[sizeof(size_t) * 8];
+	size_t depth = 0;
+	int bad_allowed = 0;
+	bool leftmost = true;
+	size_t m;
+
+	for (m = n; m > 1; m >>= 1)
+		bad_allowed++;
+
+	for (;;) {
+		while (n >= INSERTION_SORT_THRESHOLD) {
+			size_t half = n / 2;
+			char *end = a + n * es;
+			char *p;
+			size_t l, r;
+			bool already;
+
+			/* Choose a pivot and move it to a[0] */
+			if (n > NINTHER_THRESHOLD) {
+				char *mid = a + half * es;
+
+				sort3(a, mid, end - es, es, swaptype, cmp, thunk);
+				sort3(a + es, mid - es, end - 2 * es, es, swaptype, cmp, thunk);
+				sort3(a + 2 * es, mid + es, end - 3 * es, es, swaptype, cmp, thunk);
+				sort3(mid - es, mid, mid + es, es, swaptype, cmp, thunk);
+				swap(a, mid, es, swaptype);
+			} else {
+				sort3(a + half * es, a, end - es, es, swaptype, cmp, thunk);
+			}
+
+			if (!leftmost && CMP(thunk, a - es, a) >= 0) {
+				p = partition_left(a, n, es, swaptype, cmp, thunk);
+				p += es;
+				n = (end - p) / es;
+				a = p;
+				continue;
+			}
+
+			p = partition_right(a, n, es, swaptype, cmp, thunk, &already);
+			l = (p - a) / es;
+			r = n - l - 1;
+
+			if (l < n / 8 || r < n / 8) {
+				if (--bad_allowed == 0) {
+					heap_sort(a, n, es, swaptype, cmp, thunk);
+					break;
+				}
+				if (l >= INSERTION_SORT_THRESHOLD)
+					break_patterns(a, l, es, swaptype);
+				if (r >= INSERTION_SORT_THRESHOLD)
+					break_patterns(p + es, r, es, swaptype);
+			} else if (already &&
+				   partial_insertion_sort(a, l, es, swaptype, cmp, thunk) &&
+				   partial_insertion_sort(p + es, r, es, swaptype, cmp, thunk)) {
+				n = 0;
+				break;
+			}
+
+			/* Save the larger side and carry on with the smaller one */
+			if (l < r) {
+				stack[depth].a = p + es;
+				stack[depth].n = r;
+				stack[depth].leftmost = false;
+				n = l;
+			} else {
+				stack[depth].a = a;
+				stack[depth].n = l;
+				stack[depth].leftmost = leftmost;
+				a = p + es;
+				n = r;
+				leftmost = false;
+			}
+			stack[depth].bad_allowed = bad_allowed;
+			depth++;
+		}
+		if (n < INSERTION_SORT_THRESHOLD)
+			insertion_sort(a, n, es, swaptype, cmp, thunk);
+		if (depth == 0)
+			break;
+		depth--;
+		a = stack[depth].a;
+		n = stack[depth].n;
+		bad_allowed = stack[depth].bad_allowed;
+		leftmost = stack[depth].leftmost;
+	}
+}
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+/*
+ * Copies of the engine with the element size and swap unit known at
+ * compile time, so that swaps become single loads and stores
+ */
+#define SORT_FIXED(name, size, type)					\
+static __noinline void							\
+name(char *a, size_t n, cmp_t *cmp, void *thunk)			\
+{									\
+	sort_engine(a, n, size, type, cmp, thunk);			\
+}
+
+SORT_FIXED(sort_4, 4, SWAP_U32)
+SORT_FIXED(sort_8, 8, SWAP_U64)
+SORT_FIXED(sort_16, 16, SWAP_U64)
+#endif
+
+static __noinline void
+sort_generic(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk)
+{
+	sort_engine(a, n, es, swap_type(a, es), cmp, thunk);
+}
 
 #if defined(I_AM_QSORT_R)
 void
@@ -184,162 +477,29 @@ qsort (void *a,
 	cmp_t *cmp)
 #endif
 {
-	char *pa, *pb, *pc, *pd, *pl, *pm, *pn;
-	size_t d, r;
-	int cmp_result;
-	int swaptype, swap_cnt;
-	size_t recursion_level = 0;
-	struct { void *a; size_t n; } parameter_stack[PARAMETER_STACK_LEVELS];
-
-	SWAPINIT(a, es);
-loop:	swap_cnt = 0;
-	if (n < 7) {
-		/* Short arrays are insertion sorted. */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
-		goto pop;
-	}
-
-	/* Select a pivot element, move it to the left. */
-	pm = (char *) a + (n / 2) * es;
-	if (n > 7) {
-		pl = a;
-		pn = (char *) a + (n - 1) * es;
-		if (n > 40) {
-			d = (n / 8) * es;
-			pl = med3(pl, pl + d, pl + 2 * d, cmp, thunk);
-			pm = med3(pm - d, pm, pm + d, cmp, thunk);
-			pn = med3(pn - 2 * d, pn - d, pn, cmp, thunk);
+	if (n < 2 || es == 0)
+		return;
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+	switch (es) {
+	case 4:
+		if (swap_type(a, es) != SWAP_BYTES) {
+			sort_4(a, n, cmp, thunk);
+			return;
 		}
-		pm = med3(pl, pm, pn, cmp, thunk);
-	}
-	swap(a, pm);
-
-	/*
-	 * Sort the array relative the pivot in four ranges as follows:
-	 * { elems == pivot, elems < pivot, elems > pivot, elems == pivot }
-	 */
-	pa = pb = (char *) a + es;
-	pc = pd = (char *) a + (n - 1) * es;
-	for (;;) {
-		/* Scan left to right stopping at first element > pivot. */
-		while (pb <= pc && (cmp_result = CMP(thunk, pb, a)) <= 0) {
-			/* Move elements == pivot to the left (to pa) */
-			if (cmp_result == 0) {
-				swap_cnt = 1;
-				swap(pa, pb);
-				pa += es;
-			}
-			pb += es;
+		break;
+	case 8:
+		if (swap_type(a, es) == SWAP_U64) {
+			sort_8(a, n, cmp, thunk);
+			return;
 		}
-		/* Scan right to left stopping at first element < pivot. */
-		while (pb <= pc && (cmp_result = CMP(thunk, pc, a)) >= 0) {
-			/* Move elements == pivot to the right (to pd) */
-			if (cmp_result == 0) {
-				swap_cnt = 1;
-				swap(pc, pd);
-				pd -= es;
-			}
-			pc -= es;
+		break;
+	case 16:
+		if (swap_type(a, es) == SWAP_U64) {
+			sort_16(a, n, cmp, thunk);
+			return;
 		}
-		if (pb > pc)
-			break;
-		/* The scan has found two elements to swap with each other. */
-		swap(pb, pc);
-		swap_cnt = 1;
-		pb += es;
-		pc -= es;
-	}
-	if (swap_cnt == 0) {  /* Switch to insertion sort */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
-		goto pop;
+		break;
 	}
-
-	/*
-	 * Rearrange the array in three parts sorted like this:
-	 * { elements < pivot, elements == pivot, elements > pivot }
-	 */
-	pn = (char *) a + n * es;
-	r = min(pa - (char *)a, pb - pa);
-	vecswap(a, pb - r, r);
-	r = min(pd - pc, pn - pd - es);
-	vecswap(pb, pn - r, r);
-	d = pb - pa; /* d = Size of left part. */
-	r = pd - pc; /* r = Size of right part. */
-	pn -= r;     /* pn = Base of right part. */
-
-	/*
-	 * Check which of the left and right parts are larger.
-	 * Set (a, n)  to (base, size) of the larger part.
-	 * Set (pa, r) to (base, size) of the smaller part.
-	 */
-	if (r > d) { /* Right part is the larger part */
-		pa = a;
-		a = pn;
-		n = r;
-		r = d;
-	}
-	else { /* Left part is the larger part, or both are equal. */
-		pa = pn;
-		n = d;
-	}
-
-	/*
-	 * The left and right parts each need further sorting if they
-	 * contain two elements or more. If both need sorting we use
-	 * recursion to sort the smaller part and save the larger part
-	 * to be sorted by iteration after the recursion.
-	 * Using recursion only for the smaller part guarantees a
-	 * recursion depth that is bounded to be less than (log2(n)).
-	 */
-	if (r > es) {  /* Smaller part > 1 element. Both parts need sorting. */
-		if (recursion_level < PARAMETER_STACK_LEVELS) {
-			/*
-			 * The smaller part needs to be recursively sorted
-			 * before the larger part is sorted. To avoid function
-			 * call recursion the parameters for the larger part
-			 * are pushed on the parameter_stack array. The smaller
-			 * part is sorted using iteration and the larger part
-			 * will be sorted when the parameter_stack is popped
-			 * after the smaller part has been sorted.
-			 */
-			parameter_stack[recursion_level].a = a;
-			parameter_stack[recursion_level].n = n / es;
-			recursion_level++;
-			a = pa;
-			n = r / es;
-			goto loop;
-		}
-		else {
-			/*
-			 * The parameter_stack array is full. The smaller part
-			 * is sorted using function call recursion. The larger
-			 * part will be sorted after the function call returns.
-			 */
-#if defined(I_AM_QSORT_R)
-			__bsd_qsort_r(pa, r / es, es, thunk, cmp);
-#elif defined(I_AM_GNU_QSORT_R)
-			qsort_r(pa, r / es, es, cmp, thunk);
-#else
-			qsort(pa, r / es, es, cmp);
 #endif
-		}
-	}
-	if (n > es) {  /* The larger part needs sorting. Iterate to sort.  */
-		n = n / es;
-		goto loop;
-	}
-	/* Both left and right parts are one element or less - level done. */
-pop:
-	if (recursion_level != 0) {
-		recursion_level--;
-		a = parameter_stack[recursion_level].a;
-		n = parameter_stack[recursion_level].n;
-		goto loop;
-	}
+	sort_generic(a, n, es, cmp, thunk);
 }
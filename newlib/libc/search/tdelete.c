@@ -47,8 +47,7 @@ __RCSID("$NetBSD: tdelete.c,v 1.2 1999/09/16 11:45:37 lukem Exp $");
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
+#include "tnode.h"
 #include <stdlib.h>
 
 
@@ -59,36 +58,67 @@ tdelete (const void *__restrict vkey,	/* key to be deleted */
 	int       (*compar)(const void *, const void *))
 {
 	node_t **rootp = (node_t **)vrootp;
+	node_t **path[TNODE_MAX_PATH];	/* links followed from the root */
+	unsigned char right[TNODE_MAX_PATH];
 	node_t *p, *q, *r;
 	int  cmp;
+	int  depth = 0, target;
 
-	if (rootp == NULL || (p = *rootp) == NULL)
+	if (rootp == NULL || *rootp == NULL)
 		return NULL;
 
+	/*
+	 * The parent doesn't change during rebalancing, it just may
+	 * not be the parent any longer. Deleting the root returns the
+	 * (non-NULL) root pointer address.
+	 */
+	p = (node_t *) vrootp;
+	path[0] = rootp;
 	while ((cmp = (*compar)(vkey, (*rootp)->key)) != 0) {
 		p = *rootp;
+		right[depth++] = cmp > 0;
 		rootp = (cmp < 0) ?
 		    &(*rootp)->llink :		/* follow llink branch */
 		    &(*rootp)->rlink;		/* follow rlink branch */
 		if (*rootp == NULL)
 			return NULL;		/* key not found */
+		path[depth] = rootp;
 	}
-	r = (*rootp)->rlink;			/* D1: */
-	if ((q = (*rootp)->llink) == NULL)	/* Left NULL? */
-		q = r;
-	else if (r != NULL) {			/* Right link is NULL? */
-		if (r->llink == NULL) {		/* D2: Find successor */
-			r->llink = q;
-			q = r;
-		} else {			/* D3: Find NULL link */
-			for (q = r->llink; q->llink != NULL; q = r->llink)
-				r = q;
-			r->llink = q->rlink;
-			q->llink = (*rootp)->llink;
-			q->rlink = (*rootp)->rlink;
+	q = *rootp;
+	target = depth;
+
+	if (q->llink == NULL || q->rlink == NULL) {
+		/* D1: at most one child, which takes the node's place */
+		*rootp = q->llink != NULL ? q->llink : q->rlink;
+	} else {
+		/* D2: move the successor node into the deleted one's place */
+		right[depth++] = 1;
+		path[depth] = &q->rlink;
+		for (r = q->rlink; r->llink != NULL; r = r->llink) {
+			right[depth++] = 0;
+			path[depth] = &r->llink;
 		}
+		*path[depth] = r->rlink;	/* unlink the successor */
+		r->llink = q->llink;
+		r->rlink = q->rlink;
+		r->balance = q->balance;
+		*rootp = r;
+		path[target + 1] = &r->rlink;
+	}
+	__tnode_free(q);			/* D4: Free node */
+
+	/*
+	 * The subtree at path[depth] is now one shorter; walk back up
+	 * until some subtree keeps its height
+	 */
+	while (depth-- > 0) {
+		node_t *n = *path[depth];
+
+		n->balance -= right[depth] ? 1 : -1;
+		if (n->balance == 1 || n->balance == -1)
+			break;
+		if (n->balance != 0 && !__tnode_rotate(path[depth]))
+			break;
 	}
-	free(*rootp);				/* D4: Free node */
-	*rootp = q;				/* link parent to new node */
 	return p;
 }
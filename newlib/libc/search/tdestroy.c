@@ -47,8 +47,7 @@ __RCSID("$NetBSD: tdelete.c,v 1.2 1999/09/16 11:45:37 lukem Exp $");
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
+#include "tnode.h"
 #include <stdlib.h>
 
 
@@ -64,7 +63,7 @@ trecurse(root, free_action)
     trecurse(root->rlink, free_action);
 
   (*free_action) ((void *) root->key);
-  free(root);
+  __tnode_free(root);
 }
 
 void
@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "tnode.h"
+#include <stdlib.h>
+#include <malloc.h>
+
+/*
+ * Rebalance the subtree at *link, whose root has a balance of +2 or
+ * -2, with a single or double rotation. Returns non-zero if the
+ * subtree ended up shorter than before, which is always the case
+ * after an insertion and tells tdelete whether to keep going up.
+ */
+int
+__tnode_rotate(node_t **link)
+{
+	node_t *a = *link;
+	int right = a->balance > 0;	/* the heavy side */
+	int s = right ? 1 : -1;
+	node_t *b = *TNODE_LINK(a, right);
+	node_t *c;
+
+	if (b->balance != -s) {
+		*TNODE_LINK(a, right) = *TNODE_LINK(b, !right);
+		*TNODE_LINK(b, !right) = a;
+		*link = b;
+		if (b->balance == 0) {
+			a->balance = s;
+			b->balance = -s;
+			return 0;
+		}
+		a->balance = b->balance = 0;
+		return 1;
+	}
+
+	c = *TNODE_LINK(b, !right);
+	*TNODE_LINK(b, !right) = *TNODE_LINK(c, right);
+	*TNODE_LINK(a, right) = *TNODE_LINK(c, !right);
+	*TNODE_LINK(c, !right) = a;
+	*TNODE_LINK(c, right) = b;
+	a->balance = c->balance == s ? -s : 0;
+	b->balance = c->balance == -s ? s : 0;
+	c->balance = 0;
+	*link = c;
+	return 1;
+}
+
+#if defined(_SEARCH_NODE_POOL) && _SEARCH_NODE_POOL > 0
+
+/*
+ * Nodes are carved out of blocks of _SEARCH_NODE_POOL entries and
+ * recycled through a free list threaded through rlink, so building a
+ * tree doesn't make one malloc call per key. Blocks are never handed
+ * back to malloc. The free list shares the (recursive) malloc lock.
+ */
+
+static node_t *__tnode_free_list;
+
+node_t *
+__tnode_alloc(void)
+{
+	node_t *node;
+
+	__malloc_lock();
+	node = __tnode_free_list;
+	if (node == NULL) {
+		node = malloc(_SEARCH_NODE_POOL * sizeof(node_t));
+		if (node != NULL) {
+			size_t i;
+
+			for (i = 1; i < _SEARCH_NODE_POOL - 1; i++)
+				node[i].rlink = &node[i + 1];
+			node[_SEARCH_NODE_POOL - 1].rlink = NULL;
+			__tnode_free_list = _SEARCH_NODE_POOL > 1 ? &node[1] : NULL;
+		}
+	} else
+		__tnode_free_list = node->rlink;
+	__malloc_unlock();
+	return node;
+}
+
+void
+__tnode_free(node_t *node)
+{
+	__malloc_lock();
+	node->rlink = __tnode_free_list;
+	__tnode_free_list = node;
+	__malloc_unlock();
+}
+
+#else
+
+node_t *
+__tnode_alloc(void)
+{
+	return malloc(sizeof(node_t));
+}
+
+void
+__tnode_free(node_t *node)
+{
+	free(node);
+}
+
+#endif
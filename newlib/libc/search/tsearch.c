@@ -47,8 +47,7 @@ __RCSID("$NetBSD: tsearch.c,v 1.3 1999/09/16 11:45:37 lukem Exp $");
 #endif
 
 #include <assert.h>
-#define _SEARCH_PRIVATE
-#include <search.h>
+#include "tnode.h"
 #include <stdlib.h>
 
 /* find or insert datum into search tree */
@@ -59,6 +58,9 @@ tsearch (const void *vkey,		/* key to be located */
 {
 	node_t *q;
 	node_t **rootp = (node_t **)vrootp;
+	node_t **path[TNODE_MAX_PATH];	/* links followed from the root */
+	unsigned char right[TNODE_MAX_PATH];
+	int depth = 0;
 
 	if (rootp == NULL)
 		return NULL;
@@ -69,17 +71,36 @@ tsearch (const void *vkey,		/* key to be located */
 		if ((r = (*compar)(vkey, (*rootp)->key)) == 0)	/* T2: */
 			return *rootp;		/* we found it! */
 
+		path[depth] = rootp;
+		right[depth++] = r > 0;
 		rootp = (r < 0) ?
 		    &(*rootp)->llink :		/* T3: follow left branch */
 		    &(*rootp)->rlink;		/* T4: follow right branch */
 	}
 
-	q = malloc(sizeof(node_t));		/* T5: key not found */
+	q = __tnode_alloc();			/* T5: key not found */
 	if (q != 0) {				/* make new node */
 		*rootp = q;			/* link new node to old */
 		/* LINTED const castaway ok */
 		q->key = (void *)vkey;		/* initialize new node */
 		q->llink = q->rlink = NULL;
+		q->balance = 0;
+
+		/*
+		 * Walk back up adjusting balances until a subtree
+		 * doesn't get taller; at most one rotation is needed
+		 */
+		while (depth-- > 0) {
+			node_t *p = *path[depth];
+
+			p->balance += right[depth] ? 1 : -1;
+			if (p->balance == 0)
+				break;
+			if (p->balance != 1 && p->balance != -1) {
+				__tnode_rotate(path[depth]);
+				break;
+			}
+		}
 	}
 	return q;
 }
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+
+/*
+ * Bump-pointer arenas.
+ *
+ * Allocation just advances 'cur' within the current block. Blocks
+ * added when the arena grows are chained through a small header so
+ * that mallarena_release can hand back everything allocated after a
+ * mark in one step.
+ */
+
+/* Default alignment, matching malloc */
+typedef struct {
+    char c;
+    union {
+	void *p;
+	double d;
+	long long ll;
+	size_t s;
+    } u;
+} align_arena_t;
+
+#define ARENA_ALIGN	(offsetof(align_arena_t, u))
+
+/* set when the initial region came from malloc */
+#define MALLARENA_ALLOCATED	0x1
+
+struct arena_block {
+    struct arena_block	*prev;
+    char		*end;
+};
+
+#define ARENA_BLOCK_HEAD	((sizeof(struct arena_block) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+int
+mallarena_init(struct mallarena *arena, void *buf, size_t size, size_t grow)
+{
+    arena->flags = 0;
+    if (buf == NULL && size != 0)
+    {
+	buf = malloc(size);
+	if (buf == NULL)
+	    return -1;
+	arena->flags = MALLARENA_ALLOCATED;
+    }
+    arena->base = buf;
+    arena->base_end = (char *) buf + size;
+    arena->grow = grow;
+    arena->block = NULL;
+    arena->cur = arena->base;
+    arena->end = arena->base_end;
+    return 0;
+}
+
+void
+mallarena_destroy(struct mallarena *arena)
+{
+    mallarena_reset(arena);
+    if (arena->flags & MALLARENA_ALLOCATED)
+	free(arena->base);
+    arena->base = arena->base_end = NULL;
+    arena->cur = arena->end = NULL;
+    arena->flags = 0;
+}
+
+/* Add a block with room for 'size' bytes aligned to 'align' */
+static int
+mallarena_add_block(struct mallarena *arena, size_t size, size_t align)
+{
+    struct arena_block *b;
+    size_t block_size;
+
+    if (size > SIZE_MAX - ARENA_BLOCK_HEAD - align)
+	goto nomem;
+    block_size = size + ARENA_BLOCK_HEAD + align;
+    if (block_size < arena->grow)
+	block_size = arena->grow;
+
+    b = malloc(block_size);
+    if (b == NULL)
+	goto nomem;
+    b->prev = arena->block;
+    b->end = (char *) b + block_size;
+    arena->block = b;
+    arena->cur = (char *) b + ARENA_BLOCK_HEAD;
+    arena->end = b->end;
+    return 0;
+
+nomem:
+    errno = ENOMEM;
+    return -1;
+}
+
+void *
+mallarena_alloc_aligned(struct mallarena *arena, size_t size, size_t align)
+{
+    uintptr_t p;
+
+    if (align == 0 || (align & (align - 1)) != 0)
+    {
+	errno = EINVAL;
+	return NULL;
+    }
+
+    /* Return distinct pointers for zero-sized objects, like malloc */
+    if (size == 0)
+	size = 1;
+
+    for (;;)
+    {
+	p = ((uintptr_t) arena->cur + align - 1) & ~((uintptr_t) align - 1);
+	if (p >= (uintptr_t) arena->cur && p <= (uintptr_t) arena->end &&
+	    size <= (uintptr_t) arena->end - p)
+	    break;
+	if (arena->grow == 0 || mallarena_add_block(arena, size, align) < 0)
+	{
+	    errno = ENOMEM;
+	    return NULL;
+	}
+    }
+    arena->cur = (char *) (p + size);
+    return (void *) p;
+}
+
+void *
+mallarena_alloc(struct mallarena *arena, size_t size)
+{
+    return mallarena_alloc_aligned(arena, size, ARENA_ALIGN);
+}
+
+struct mallarena_mark
+mallarena_mark(struct mallarena *arena)
+{
+    struct mallarena_mark mark = { .block = arena->block, .cur = arena->cur };
+
+    return mark;
+}
+
+void
+mallarena_release(struct mallarena *arena, struct mallarena_mark mark)
+{
+    struct arena_block *b;
+
+    /* Free blocks added since the mark */
+    while ((b = arena->block) != mark.block && b != NULL)
+    {
+	arena->block = b->prev;
+	free(b);
+    }
+    arena->cur = mark.cur;
+    arena->end = b ? b->end : arena->base_end;
+}
+
+void
+mallarena_reset(struct mallarena *arena)
+{
+    struct mallarena_mark mark = { .block = NULL, .cur = arena->base };
+
+    mallarena_release(arena, mark);
+}
@@ -0,0 +1,275 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Fixed-size object pools.
+ *
+ * Free objects form a singly linked list threaded through the objects
+ * themselves. Links are stored as object index + 1 so that zero can
+ * terminate the list.
+ *
+ * MALLPOOL_ATOMIC pools manage the list head with compare-and-swap.
+ * The upper half of the head holds a counter which changes on every
+ * update so that a stale head from a preempted thread never matches
+ * (the ABA problem). That limits atomic pools to 2^(bits/2) - 1
+ * objects. Targets without a size_t compare-and-swap use the malloc
+ * lock instead.
+ */
+
+#define MALLPOOL_TAG_SHIFT	(sizeof(size_t) * CHAR_BIT / 2)
+#define MALLPOOL_INDEX_MASK	(((size_t) 1 << MALLPOOL_TAG_SHIFT) - 1)
+#define MALLPOOL_TAG_ONE	((size_t) 1 << MALLPOOL_TAG_SHIFT)
+
+/* set when the pool storage came from malloc */
+#define MALLPOOL_ALLOCATED	0x100
+
+#if (__SIZEOF_SIZE_T__ == 2 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_2)) || \
+    (__SIZEOF_SIZE_T__ == 4 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)) || \
+    (__SIZEOF_SIZE_T__ == 8 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8))
+#define MALLPOOL_HAVE_CAS
+#endif
+
+static inline char *
+pool_obj(struct mallpool *pool, size_t idx)
+{
+    return pool->base + (idx - 1) * pool->size;
+}
+
+static inline size_t
+get_link(const char *obj)
+{
+    size_t link;
+    memcpy(&link, obj, sizeof(link));
+    return link;
+}
+
+static inline void
+set_link(char *obj, size_t link)
+{
+    memcpy(obj, &link, sizeof(link));
+}
+
+int
+mallpool_init(struct mallpool *pool, size_t size, size_t count, void *buf, int flags)
+{
+    size_t i;
+
+    size = MALLPOOL_OBJSIZE(size);
+    if (count == 0 || (flags & ~MALLPOOL_ATOMIC) != 0 ||
+	count > SIZE_MAX / size ||
+	((flags & MALLPOOL_ATOMIC) && count > MALLPOOL_INDEX_MASK))
+    {
+	errno = EINVAL;
+	return -1;
+    }
+
+    if (buf == NULL)
+    {
+	buf = malloc(count * size);
+	if (buf == NULL)
+	    return -1;
+	flags |= MALLPOOL_ALLOCATED;
+    }
+
+    pool->base = buf;
+    pool->size = size;
+    pool->count = count;
+    pool->flags = flags;
+    pool->nfree = count;
+    pool->min_free = count;
+
+    /* Link objects in address order */
+    for (i = 1; i < count; i++)
+	set_link(pool_obj(pool, i), i + 1);
+    set_link(pool_obj(pool, count), 0);
+    pool->head = 1;
+    return 0;
+}
+
+void
+mallpool_destroy(struct mallpool *pool)
+{
+    if (pool->flags & MALLPOOL_ALLOCATED)
+	free(pool->base);
+    pool->base = NULL;
+    pool->count = 0;
+    pool->nfree = 0;
+    pool->head = 0;
+}
+
+#ifdef MALLPOOL_HAVE_CAS
+static void
+pool_note_alloc(struct mallpool *pool)
+{
+    size_t n = __atomic_sub_fetch(&pool->nfree, 1, __ATOMIC_RELAXED);
+    size_t min = __atomic_load_n(&pool->min_free, __ATOMIC_RELAXED);
+
+    while (n < min &&
+	   !__atomic_compare_exchange_n(&pool->min_free, &min, n, true,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	;
+}
+#endif
+
+void *
+mallpool_alloc(struct mallpool *pool)
+{
+    size_t head, idx;
+    char *obj;
+
+#ifdef MALLPOOL_HAVE_CAS
+    if (pool->flags & MALLPOOL_ATOMIC)
+    {
+	head = __atomic_load_n(&pool->head, __ATOMIC_ACQUIRE);
+	do {
+	    idx = head & MALLPOOL_INDEX_MASK;
+	    if (idx == 0)
+	    {
+		errno = ENOMEM;
+		return NULL;
+	    }
+	    obj = pool_obj(pool, idx);
+	    /*
+	     * obj may be allocated and modified by another thread
+	     * before the exchange; the tag makes the exchange fail
+	     * in that case.
+	     */
+	} while (!__atomic_compare_exchange_n(&pool->head, &head,
+					      ((head & ~MALLPOOL_INDEX_MASK) + MALLPOOL_TAG_ONE) |
+					      get_link(obj),
+					      true, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+	pool_note_alloc(pool);
+	return obj;
+    }
+#else
+    if (pool->flags & MALLPOOL_ATOMIC)
+	__malloc_lock();
+#endif
+
+    idx = pool->head;
+    if (idx == 0)
+    {
+	obj = NULL;
+	errno = ENOMEM;
+    }
+    else
+    {
+	obj = pool_obj(pool, idx);
+	pool->head = get_link(obj);
+	if (--pool->nfree < pool->min_free)
+	    pool->min_free = pool->nfree;
+    }
+
+#ifndef MALLPOOL_HAVE_CAS
+    if (pool->flags & MALLPOOL_ATOMIC)
+	__malloc_unlock();
+#endif
+    return obj;
+}
+
+void
+mallpool_free(struct mallpool *pool, void *ptr)
+{
+    char *obj = ptr;
+    uintptr_t offset;
+    size_t idx;
+
+    if (obj == NULL)
+	return;
+
+    /* Reject pointers which don't refer to an object in this pool */
+    offset = (uintptr_t) obj - (uintptr_t) pool->base;
+    if (offset % pool->size != 0 || offset / pool->size >= pool->count)
+    {
+	errno = EINVAL;
+	return;
+    }
+    idx = offset / pool->size + 1;
+
+#ifdef MALLPOOL_HAVE_CAS
+    if (pool->flags & MALLPOOL_ATOMIC)
+    {
+	size_t head = __atomic_load_n(&pool->head, __ATOMIC_RELAXED);
+
+	do {
+	    set_link(obj, head & MALLPOOL_INDEX_MASK);
+	} while (!__atomic_compare_exchange_n(&pool->head, &head,
+					      ((head & ~MALLPOOL_INDEX_MASK) + MALLPOOL_TAG_ONE) | idx,
+					      true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	__atomic_add_fetch(&pool->nfree, 1, __ATOMIC_RELAXED);
+	return;
+    }
+#else
+    if (pool->flags & MALLPOOL_ATOMIC)
+	__malloc_lock();
+#endif
+
+    set_link(obj, pool->head);
+    pool->head = idx;
+    pool->nfree++;
+
+#ifndef MALLPOOL_HAVE_CAS
+    if (pool->flags & MALLPOOL_ATOMIC)
+	__malloc_unlock();
+#endif
+}
+
+/*
+ * Report pool usage in mallinfo terms: arena is the pool size,
+ * ordblks the number of free objects, uordblks and fordblks the bytes
+ * in use and free, and usmblks the most bytes ever in use at once.
+ */
+struct mallinfo
+mallpool_info(struct mallpool *pool)
+{
+    struct mallinfo info;
+    size_t nfree = pool->nfree;
+
+    memset(&info, 0, sizeof(info));
+    info.arena = pool->count * pool->size;
+    info.ordblks = nfree;
+    info.fordblks = nfree * pool->size;
+    info.uordblks = info.arena - info.fordblks;
+    info.usmblks = (pool->count - pool->min_free) * pool->size;
+    return info;
+}
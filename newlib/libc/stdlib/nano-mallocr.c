@@ -38,6 +38,8 @@
 #include <errno.h>
 #include <malloc.h>
 #include <unistd.h>
+#include <limits.h>
+#include <stdint.h>
 #include <sys/config.h>
 
 #if MALLOC_DEBUG
@@ -96,8 +98,40 @@ typedef struct malloc_chunk
 
     /* pointer to next chunk */
     struct malloc_chunk * next;
+
+#ifdef _NANO_MALLOC_SEGREGATED
+    /* pointer to previous chunk in the same size bin */
+    struct malloc_chunk * prev;
+#endif
 } chunk_t;
 
+#ifdef _NANO_MALLOC_SEGREGATED
+
+/*
+ * In segregated mode, free chunks are kept in per-size bins, and
+ * neighbouring chunks are found through boundary tags instead of by
+ * walking an address-ordered list:
+ *
+ *  - the low bit of 'size' is set when the chunk immediately
+ *    below in memory is free (MALLOC_PREV_FREE),
+ *
+ *  - the last size_t of every free chunk holds its size, so that
+ *    the chunk above can locate the start of it,
+ *
+ *  - every region obtained from sbrk ends with a zero-sized,
+ *    never-free 'fence' chunk which stops coalescing at the end of
+ *    the region.
+ *
+ * Keep chunk sizes even so that the low bit of 'size' is available.
+ */
+#define MALLOC_PREV_FREE	((size_t) 1)
+#define MALLOC_CHUNK_ALIGN	MAX(offsetof(align_chunk_t, u), 2)
+#define MALLOC_HEAD_ALIGN	MAX(offsetof(align_head_t, s), 2)
+
+#else
+
+#define MALLOC_PREV_FREE	((size_t) 0)
+
 /* Alignment of allocated chunk. Compute the alignment required from a
  * range of types */
 #define MALLOC_CHUNK_ALIGN	(offsetof(align_chunk_t, u))
@@ -105,6 +139,8 @@ typedef struct malloc_chunk
 /* Alignment of the header. Never larger than MALLOC_CHUNK_ALIGN */
 #define MALLOC_HEAD_ALIGN	(offsetof(align_head_t, s))
 
+#endif
+
 /* Size of malloc header. Keep it aligned. */
 #define MALLOC_HEAD 		ALIGN_TO(sizeof(size_t), MALLOC_HEAD_ALIGN)
 
@@ -112,15 +148,51 @@ typedef struct malloc_chunk
 #define MALLOC_PAGE_ALIGN 	(0x1000)
 
 /* Minimum allocation size */
+#ifdef _NANO_MALLOC_SEGREGATED
+/* Leave room for the size stored at the end of a free chunk */
+#define MALLOC_MINSIZE		ALIGN_TO(sizeof(chunk_t) + sizeof(size_t), MALLOC_CHUNK_ALIGN)
+
+/* Space reserved at the end of each sbrk region for the fence */
+#define MALLOC_FENCE		ALIGN_TO(MALLOC_HEAD, MALLOC_CHUNK_ALIGN)
+
+/* One bin for each power of two */
+#define MALLOC_NBINS		(sizeof(size_t) * CHAR_BIT)
+#else
 #define MALLOC_MINSIZE		ALIGN_TO(sizeof(chunk_t), MALLOC_HEAD_ALIGN)
+#endif
 
 /* Maximum allocation size */
 #define MALLOC_MAXSIZE 		(SIZE_MAX - (MALLOC_HEAD + 2*MALLOC_CHUNK_ALIGN))
 
+#ifdef _NANO_MALLOC_THREAD_CACHE
+/* Largest chunk held in the per-thread cache */
+#ifndef MALLOC_CACHE_MAX
+#define MALLOC_CACHE_MAX	256
+#endif
+
+/* Number of chunks moved to or from the shared pool at once */
+#define MALLOC_CACHE_BATCH	8
+
+/* Number of chunks of each size held by a thread */
+#define MALLOC_CACHE_DEPTH	(2 * MALLOC_CACHE_BATCH)
+
+/* One list for each chunk size up to MALLOC_CACHE_MAX */
+#define MALLOC_CACHE_CLASSES	((MALLOC_CACHE_MAX - MALLOC_MINSIZE) / MALLOC_CHUNK_ALIGN + 1)
+#endif
+
 /* Forward data declarations */
+#ifdef _NANO_MALLOC_SEGREGATED
+extern chunk_t * __malloc_bins[MALLOC_NBINS];
+extern size_t __malloc_bin_map;
+#else
 extern chunk_t * __malloc_free_list;
+#endif
 extern char * __malloc_sbrk_start;
 extern char * __malloc_sbrk_top;
+#ifdef _NANO_MALLOC_THREAD_CACHE
+extern NEWLIB_THREAD_LOCAL chunk_t * __malloc_cache[MALLOC_CACHE_CLASSES];
+extern NEWLIB_THREAD_LOCAL unsigned char __malloc_cache_count[MALLOC_CACHE_CLASSES];
+#endif
 
 /* Forward function declarations */
 void * malloc(size_t);
@@ -138,11 +210,16 @@ void __malloc_validate(void);
 void __malloc_validate_block(chunk_t *r);
 void * __malloc_sbrk_aligned(size_t s);
 bool __malloc_grow_chunk(chunk_t *c, size_t new_size);
+void __malloc_cache_flush(void);
 
 /* Work around compiler optimizing away stores to 'size' field before
- * call to free.
+ * call to free. With statistics enabled, these are the allocator
+ * itself and malloc/free wrap them to call the hooks
  */
-#ifdef HAVE_ALIAS_ATTRIBUTE
+#ifdef _NANO_MALLOC_STATS
+void * __malloc_malloc(size_t s);
+void __malloc_free(void * free_p);
+#elif defined(HAVE_ALIAS_ATTRIBUTE)
 extern typeof(free) __malloc_free;
 extern typeof(malloc) __malloc_malloc;
 #else
@@ -164,11 +241,25 @@ chunk_to_ptr(chunk_t *c)
     return (char *) c + MALLOC_HEAD;
 }
 
+/* size of chunk, without any flags */
+static inline size_t
+chunk_get_size(chunk_t *c)
+{
+    return c->size & ~MALLOC_PREV_FREE;
+}
+
+/* change the size of an existing chunk, preserving any flags */
+static inline void
+chunk_set_size(chunk_t *c, size_t size)
+{
+    c->size = size | (c->size & MALLOC_PREV_FREE);
+}
+
 /* end of chunk -- address of first byte past chunk storage */
 static inline void *
 chunk_end(chunk_t *c)
 {
-    return (char *) c + c->size;
+    return (char *) c + chunk_get_size(c);
 }
 
 /* chunk size needed to hold 'malloc_size' bytes */
@@ -193,10 +284,10 @@ chunk_size(size_t malloc_size)
 static inline size_t
 chunk_usable(chunk_t *c)
 {
-    return c->size - MALLOC_HEAD;
+    return chunk_get_size(c) - MALLOC_HEAD;
 }
 
-/* assign 'size' to the specified chunk and return it to the free
+/* assign 'size' to the specified new chunk and return it to the free
  * pool */
 static inline void
 make_free_chunk(chunk_t *c, size_t size)
@@ -205,14 +296,245 @@ make_free_chunk(chunk_t *c, size_t size)
     __malloc_free(chunk_to_ptr(c));
 }
 
+#ifdef _NANO_MALLOC_STATS
+
+#if (__SIZEOF_SIZE_T__ == 2 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_2)) || \
+    (__SIZEOF_SIZE_T__ == 4 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)) || \
+    (__SIZEOF_SIZE_T__ == 8 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8))
+#define MALLOC_STATS_HAVE_CAS
+#endif
+
+extern struct mallstats __malloc_stats;
+extern mallstats_hook_t __malloc_alloc_hook;
+extern mallstats_hook_t __malloc_free_hook;
+
+/* Call an allocation hook, passing the address of our caller */
+#define MALLOC_HOOK(hook, ptr, size) do {				\
+	mallstats_hook_t __hook = __atomic_load_n(&(hook), __ATOMIC_RELAXED); \
+	if (__hook)							\
+	    __hook(ptr, size, __builtin_return_address(0));		\
+    } while(0)
+
+/* counter for chunks of 'size' bytes */
+static inline unsigned
+stats_class(size_t size)
+{
+    return (unsigned) (sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl((unsigned long) size));
+}
+
+static inline void
+stats_add(size_t *counter, size_t n)
+{
+#ifdef MALLOC_STATS_HAVE_CAS
+    __atomic_add_fetch(counter, n, __ATOMIC_RELAXED);
+#else
+    MALLOC_LOCK;
+    __atomic_store_n(counter, *counter + n, __ATOMIC_RELAXED);
+    MALLOC_UNLOCK;
+#endif
+}
+
+/* Move the accounting for an allocated chunk from 'old_size' to
+ * 'new_size' bytes. Zero means the chunk is being allocated or freed
+ */
+static inline void
+stats_update(size_t old_size, size_t new_size)
+{
+    size_t in_use;
+
+    if (old_size)
+	stats_add(&__malloc_stats.count[stats_class(old_size)], (size_t) -1);
+    if (new_size)
+	stats_add(&__malloc_stats.count[stats_class(new_size)], 1);
+#ifdef MALLOC_STATS_HAVE_CAS
+    in_use = __atomic_add_fetch(&__malloc_stats.in_use, new_size - old_size, __ATOMIC_RELAXED);
+
+    size_t max = __atomic_load_n(&__malloc_stats.max_in_use, __ATOMIC_RELAXED);
+    while (in_use > max &&
+	   !__atomic_compare_exchange_n(&__malloc_stats.max_in_use, &max, in_use, true,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	;
+#else
+    MALLOC_LOCK;
+    in_use = __malloc_stats.in_use + new_size - old_size;
+    __atomic_store_n(&__malloc_stats.in_use, in_use, __ATOMIC_RELAXED);
+    if (in_use > __malloc_stats.max_in_use)
+	__atomic_store_n(&__malloc_stats.max_in_use, in_use, __ATOMIC_RELAXED);
+    MALLOC_UNLOCK;
+#endif
+}
+
+/* Split 'piece' bytes off the end of an allocated 'size' byte chunk */
+static inline void
+stats_split(size_t size, size_t piece)
+{
+    stats_update(size, size - piece);
+    stats_update(0, piece);
+}
+
+static inline void
+stats_failed(void)
+{
+    stats_add(&__malloc_stats.failed, 1);
+}
+
+static inline void
+stats_sbrk(size_t size)
+{
+    stats_add(&__malloc_stats.sbrk_calls, 1);
+    stats_add(&__malloc_stats.arena, size);
+}
+
+/* Find the largest free chunk. Called with the malloc lock held */
+static inline void
+stats_free_scan(void)
+{
+    size_t largest = 0;
+    chunk_t *r;
+
+#ifdef _NANO_MALLOC_SEGREGATED
+    /* It must be in the highest non-empty bin */
+    if (__malloc_bin_map)
+	r = __malloc_bins[sizeof(unsigned long) * CHAR_BIT - 1 -
+			  __builtin_clzl((unsigned long) __malloc_bin_map)];
+    else
+	r = NULL;
+#else
+    r = __malloc_free_list;
+#endif
+    for (; r; r = r->next)
+	largest = MAX(largest, chunk_get_size(r));
+    __atomic_store_n(&__malloc_stats.largest_free, largest, __ATOMIC_RELAXED);
+}
+
+/* Note a chunk of 'size' bytes entering the free pool */
+static inline void
+stats_free_add(size_t size)
+{
+    if (size > __malloc_stats.largest_free)
+	__atomic_store_n(&__malloc_stats.largest_free, size, __ATOMIC_RELAXED);
+}
+
+/* Note a chunk of 'size' bytes leaving the free pool */
+static inline void
+stats_free_remove(size_t size)
+{
+    if (size >= __malloc_stats.largest_free)
+	stats_free_scan();
+}
+
+#else
+
+static inline void stats_update(size_t old_size, size_t new_size) { (void) old_size; (void) new_size; }
+static inline void stats_split(size_t size, size_t piece) { (void) size; (void) piece; }
+static inline void stats_failed(void) { }
+static inline void stats_sbrk(size_t size) { (void) size; }
+static inline void stats_free_add(size_t size) { (void) size; }
+static inline void stats_free_remove(size_t size) { (void) size; }
+
+#endif /* _NANO_MALLOC_STATS */
+
+#ifdef _NANO_MALLOC_SEGREGATED
+
+/* bin holding free chunks of 'size' bytes */
+static inline unsigned
+chunk_bin(size_t size)
+{
+    return (unsigned) (sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl((unsigned long) size));
+}
+
+/* is the chunk free? Fences are never free */
+static inline bool
+chunk_is_free(chunk_t *c)
+{
+    size_t size = chunk_get_size(c);
+
+    return size != 0 && (((chunk_t *) ((char *) c + size))->size & MALLOC_PREV_FREE) != 0;
+}
+
+/* add a chunk to the right bin and mark it free */
+static inline void
+bin_insert(chunk_t *c)
+{
+    size_t size = chunk_get_size(c);
+    chunk_t *n = chunk_end(c);
+    unsigned b = chunk_bin(size);
+
+    ((size_t *) n)[-1] = size;
+    n->size |= MALLOC_PREV_FREE;
+
+    c->prev = NULL;
+    c->next = __malloc_bins[b];
+    if (c->next)
+	c->next->prev = c;
+    __malloc_bins[b] = c;
+    __malloc_bin_map |= (size_t) 1 << b;
+    stats_free_add(size);
+}
+
+/* remove a chunk from its bin. The caller updates the free flag */
+static inline void
+bin_remove(chunk_t *c)
+{
+    size_t size = chunk_get_size(c);
+    unsigned b = chunk_bin(size);
+
+    if (c->prev)
+	c->prev->next = c->next;
+    else if ((__malloc_bins[b] = c->next) == NULL)
+	__malloc_bin_map &= ~((size_t) 1 << b);
+    if (c->next)
+	c->next->prev = c->prev;
+    stats_free_remove(size);
+}
+
+/* merge an in-use chunk with any free neighbours and put the result
+ * in the right bin */
+static inline void
+chunk_release(chunk_t *c)
+{
+    size_t size = chunk_get_size(c);
+    chunk_t *n = chunk_end(c);
+
+    if (c->size & MALLOC_PREV_FREE)
+    {
+	size_t prev_size = ((size_t *) c)[-1];
+
+	c = (chunk_t *) ((char *) c - prev_size);
+	bin_remove(c);
+	size += prev_size;
+    }
+    if (chunk_is_free(n))
+    {
+	bin_remove(n);
+	size += chunk_get_size(n);
+    }
+    c->size = size;
+    bin_insert(c);
+}
+
+#endif /* _NANO_MALLOC_SEGREGATED */
+
 #ifdef DEFINE_MALLOC
+#ifdef _NANO_MALLOC_SEGREGATED
+/* Free chunks, sorted by size */
+chunk_t * __malloc_bins[MALLOC_NBINS];
+
+/* Set of non-empty bins */
+size_t __malloc_bin_map;
+#else
 /* List list header of free blocks */
 chunk_t * __malloc_free_list;
+#endif
 
 /* Starting point of memory allocated from system */
 char * __malloc_sbrk_start;
 char * __malloc_sbrk_top;
 
+#ifdef _NANO_MALLOC_STATS
+struct mallstats __malloc_stats;
+#endif
+
 /** Function __malloc_sbrk_aligned
   * Algorithm:
   *   Use sbrk() to obtain more memory and ensure the storage is
@@ -246,8 +568,6 @@ void* __malloc_sbrk_aligned(size_t s)
     if (p == (void *)-1)
         return p;
 
-    __malloc_sbrk_top = p + s;
-
     /* Adjust returned space so that the storage area
      * is MALLOC_CHUNK_ALIGN aligned and the head is
      * MALLOC_HEAD_ALIGN aligned.
@@ -266,12 +586,163 @@ void* __malloc_sbrk_aligned(size_t s)
         char *extra = sbrk(adjust);
         if (extra != p + s)
             return (void *) -1;
-	__malloc_sbrk_top = extra + adjust;
     }
 
+    __malloc_sbrk_top = align_p + s;
+    stats_sbrk(__malloc_sbrk_top - p);
+
     return align_p;
 }
 
+#ifdef _NANO_MALLOC_SEGREGATED
+
+/* Add a fence to the end of a new sbrk region and put the rest of it
+ * in the free bins */
+static void
+__malloc_add_region(chunk_t *c, size_t size)
+{
+    c->size = size;
+    ((chunk_t *) chunk_end(c))->size = 0;
+    chunk_release(c);
+}
+
+/* Ask sbrk for enough memory to hold an 'alloc_size' chunk and add it
+ * to the free bins. Memory contiguous with the previous region replaces
+ * the old fence and extends any free chunk at the end of it.
+ */
+static bool
+__malloc_more_core(size_t alloc_size)
+{
+    char *top = __malloc_sbrk_top;
+    size_t size = alloc_size;
+    chunk_t *c;
+
+    if (top)
+    {
+	chunk_t *fence = (chunk_t *) (top - MALLOC_FENCE);
+
+	if (fence->size & MALLOC_PREV_FREE)
+	    size = MAX(MALLOC_MINSIZE, alloc_size - ((size_t *) fence)[-1]);
+    }
+
+    if (size > PTRDIFF_MAX - MALLOC_FENCE)
+	return false;
+
+    c = __malloc_sbrk_aligned(size + MALLOC_FENCE);
+    if (c == (void *) -1)
+	return false;
+
+    if ((char *) c == top)
+    {
+	c = (chunk_t *) (top - MALLOC_FENCE);
+	chunk_set_size(c, size + MALLOC_FENCE);
+	((chunk_t *) chunk_end(c))->size = 0;
+	chunk_release(c);
+    }
+    else
+	__malloc_add_region(c, size);
+    return true;
+}
+
+/* Extend an in-use chunk which sits just below the fence at the top
+ * of memory */
+bool
+__malloc_grow_chunk(chunk_t *c, size_t new_size)
+{
+    char *chunk_e = chunk_end(c);
+    char *top = __malloc_sbrk_top;
+
+    if (chunk_e + MALLOC_FENCE != top)
+	return false;
+    size_t add_size = MAX(MALLOC_MINSIZE, new_size - chunk_get_size(c));
+
+    /* Ask for the extra memory needed */
+    char *heap = __malloc_sbrk_aligned(add_size);
+
+    /* Check if we got what we wanted */
+    if (heap == top)
+    {
+	/* Set size, move the fence and return */
+	chunk_set_size(c, chunk_get_size(c) + add_size);
+	((chunk_t *) chunk_end(c))->size = 0;
+	return true;
+    }
+
+    if (heap != (char *) -1 && add_size >= MALLOC_MINSIZE + MALLOC_FENCE)
+    {
+	/* sbrk returned unexpected memory, free it */
+	__malloc_add_region((chunk_t *) heap, add_size - MALLOC_FENCE);
+    }
+    return false;
+}
+
+/** Function __malloc_get_chunk
+  * Algorithm:
+  *   Search the bin for the requested size, then take the first chunk
+  *   from the smallest larger non-empty bin. If that fails, call sbrk
+  *   to add more memory and try again.
+  */
+static chunk_t *
+__malloc_get_chunk(size_t alloc_size)
+{
+    chunk_t *r;
+
+    MALLOC_LOCK;
+
+    for (;;)
+    {
+	unsigned b = chunk_bin(alloc_size);
+	size_t map;
+
+	/* Chunks in this bin may be too small */
+	for (r = __malloc_bins[b]; r != NULL; r = r->next)
+	    if (chunk_get_size(r) >= alloc_size)
+		break;
+
+	if (r == NULL)
+	{
+	    /* Any chunk in a larger bin will do */
+	    map = __malloc_bin_map & ~(((size_t) 2 << b) - 1);
+	    if (map)
+		r = __malloc_bins[__builtin_ctzl((unsigned long) map)];
+	}
+
+	if (r != NULL)
+	    break;
+
+	if (!__malloc_more_core(alloc_size))
+	{
+	    MALLOC_UNLOCK;
+	    return NULL;
+	}
+    }
+
+    bin_remove(r);
+
+    size_t rem = chunk_get_size(r) - alloc_size;
+
+    if (rem >= MALLOC_MINSIZE)
+    {
+	/* Split off the end and return it to the bins */
+	chunk_set_size(r, alloc_size);
+
+	chunk_t *n = chunk_end(r);
+	n->size = rem;
+	bin_insert(n);
+    }
+    else
+    {
+	/* Use the whole chunk */
+	((chunk_t *) chunk_end(r))->size &= ~MALLOC_PREV_FREE;
+    }
+
+    MALLOC_UNLOCK;
+
+    return r;
+}
+
+#else
+
 bool
 __malloc_grow_chunk(chunk_t *c, size_t new_size)
 {
@@ -295,29 +766,21 @@ __malloc_grow_chunk(chunk_t *c, size_t new_size)
     if (heap != (char *) -1)
     {
 	/* sbrk returned unexpected memory, free it */
+	stats_update(0, add_size);
 	make_free_chunk((chunk_t *) heap, add_size);
     }
     return false;
 }
 
-/** Function malloc
+/** Function __malloc_get_chunk
   * Algorithm:
   *   Walk through the free list to find the first match. If fails to find
   *   one, call sbrk to allocate a new chunk_t.
   */
-void * malloc(size_t s)
+static chunk_t *
+__malloc_get_chunk(size_t alloc_size)
 {
     chunk_t **p, *r;
-    char * ptr;
-    size_t alloc_size;
-
-    if (s > MALLOC_MAXSIZE)
-    {
-        errno = ENOMEM;
-        return NULL;
-    }
-
-    alloc_size = chunk_size(s);
 
     MALLOC_LOCK;
 
@@ -347,6 +810,7 @@ void * malloc(size_t s)
 		 */
 		*p = r->next;
 	    }
+	    stats_free_remove(alloc_size + rem);
             break;
         }
 	if (!r->next && __malloc_grow_chunk(r, alloc_size))
@@ -355,6 +819,7 @@ void * malloc(size_t s)
 	     * just return it
 	     */
 	    *p = r->next;
+	    stats_free_remove(r->size);
 	    break;
 	}
     }
@@ -368,21 +833,116 @@ void * malloc(size_t s)
 
         /* sbrk returns -1 if fail to allocate */
         if (r == (void *)-1)
-        {
-            errno = ENOMEM;
-            MALLOC_UNLOCK;
             return NULL;
-        }
         r->size = alloc_size;
     }
 
+    return r;
+}
+#endif /* _NANO_MALLOC_SEGREGATED */
+
+#ifdef _NANO_MALLOC_THREAD_CACHE
+
+NEWLIB_THREAD_LOCAL chunk_t * __malloc_cache[MALLOC_CACHE_CLASSES];
+NEWLIB_THREAD_LOCAL unsigned char __malloc_cache_count[MALLOC_CACHE_CLASSES];
+
+/** Function __malloc_cache_get
+  * Algorithm:
+  *   Pop a chunk from this thread's cache. When the cache is empty,
+  *   take space for a batch of chunks from the shared pool with a
+  *   single lock, return the first and cache the rest.
+  */
+static chunk_t *
+__malloc_cache_get(size_t alloc_size)
+{
+    unsigned c = (alloc_size - MALLOC_MINSIZE + MALLOC_CHUNK_ALIGN - 1) / MALLOC_CHUNK_ALIGN;
+    chunk_t *r = __malloc_cache[c];
+    chunk_t *n;
+    size_t left;
+
+    if (r)
+    {
+	__malloc_cache[c] = r->next;
+	__malloc_cache_count[c]--;
+	return r;
+    }
+
+    r = __malloc_get_chunk(alloc_size * MALLOC_CACHE_BATCH);
+    if (r == NULL)
+	return __malloc_get_chunk(alloc_size);
+
+    /* Split the batch, leaving any extra in the last chunk */
+    left = chunk_get_size(r) - alloc_size;
+    chunk_set_size(r, alloc_size);
+    for (n = chunk_end(r); left; n = chunk_end(n))
+    {
+	n->size = left >= 2 * alloc_size ? alloc_size : left;
+	left -= n->size;
+	n->next = __malloc_cache[c];
+	__malloc_cache[c] = n;
+	__malloc_cache_count[c]++;
+    }
+    return r;
+}
+#endif /* _NANO_MALLOC_THREAD_CACHE */
+
+/** Function malloc
+  * Algorithm:
+  *   Find a chunk large enough for the request, either in the
+  *   thread cache or the shared pool, and clear it.
+  */
+#ifdef _NANO_MALLOC_STATS
+void * __malloc_malloc(size_t s)
+#else
+void * malloc(size_t s)
+#endif
+{
+    chunk_t *r;
+    char * ptr;
+    size_t alloc_size;
+
+    if (s > MALLOC_MAXSIZE)
+    {
+        stats_failed();
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    alloc_size = chunk_size(s);
+
+#ifdef _NANO_MALLOC_THREAD_CACHE
+    if (alloc_size <= MALLOC_CACHE_MAX)
+	r = __malloc_cache_get(alloc_size);
+    else
+#endif
+	r = __malloc_get_chunk(alloc_size);
+
+    if (r == NULL)
+    {
+        stats_failed();
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    stats_update(0, chunk_get_size(r));
+
     ptr = (char *)r + MALLOC_HEAD;
 
-    memset(ptr, '\0', alloc_size - MALLOC_HEAD);
+    /* Clear the whole chunk, which may be larger than requested */
+    memset(ptr, '\0', chunk_usable(r));
 
     return ptr;
 }
-#ifdef HAVE_ALIAS_ATTRIBUTE
+#ifdef _NANO_MALLOC_STATS
+void * malloc(size_t s)
+{
+    void *ptr = __malloc_malloc(s);
+
+    if (ptr)
+	MALLOC_HOOK(__malloc_alloc_hook, ptr, s);
+    return ptr;
+}
+#elif defined(HAVE_ALIAS_ATTRIBUTE)
 #pragma GCC diagnostic push
 #ifndef __clang__
 #pragma GCC diagnostic ignored "-Wmissing-attributes"
@@ -394,29 +954,39 @@ __strong_reference(malloc, __malloc_malloc);
 
 #ifdef DEFINE_FREE
 
-/** Function free
-  * Implementation of libc free.
+#ifdef _NANO_MALLOC_SEGREGATED
+/** Function __malloc_put_chunk
+  * Return a chunk to the free bins, merging it with free neighbours.
+  * Called with the malloc lock held.
+  */
+static void
+__malloc_put_chunk(chunk_t * p_to_free)
+{
+    /* Check for double free */
+    if (chunk_is_free(p_to_free))
+    {
+	errno = ENOMEM;
+	return;
+    }
+
+    chunk_release(p_to_free);
+}
+#else
+/** Function __malloc_put_chunk
   * Algorithm:
   *  Maintain a global free chunk_t single link list, headed by global
   *  variable __malloc_free_list.
   *  When free, insert the to-be-freed chunk_t into free list. The place to
   *  insert should make sure all chunks are sorted by address from low to
   *  high.  Then merge with neighbor chunks if adjacent.
+  *  Called with the malloc lock held.
   */
-void free (void * free_p)
+static void
+__malloc_put_chunk(chunk_t * p_to_free)
 {
-    chunk_t * p_to_free;
     chunk_t ** p, * r;
 
-    if (free_p == NULL) return;
-
-    p_to_free = ptr_to_chunk(free_p);
     p_to_free->next = NULL;
-#if MALLOC_DEBUG
-    __malloc_validate_block(p_to_free);
-#endif
-
-    MALLOC_LOCK;
 
     for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
     {
@@ -437,7 +1007,6 @@ void free (void * free_p)
 	if (p_to_free == r)
 	{
 	    errno = ENOMEM;
-	    MALLOC_UNLOCK;
 	    return;
 	}
 
@@ -453,15 +1022,123 @@ no_insert:
 	p_to_free->size += r->size;
 	p_to_free->next = r->next;
     }
+    stats_free_add(p_to_free->size);
+}
+#endif /* _NANO_MALLOC_SEGREGATED */
 
+#ifdef _NANO_MALLOC_THREAD_CACHE
+
+/* Return a list of cached chunks to the shared pool */
+static void
+__malloc_cache_release(chunk_t *list)
+{
+    chunk_t *r;
+
+    MALLOC_LOCK;
+    while ((r = list) != NULL)
+    {
+	list = r->next;
+	__malloc_put_chunk(r);
+    }
     MALLOC_UNLOCK;
 }
+
+/* Empty this thread's cache */
+void
+__malloc_cache_flush(void)
+{
+    chunk_t *list = NULL;
+    unsigned c;
+
+    for (c = 0; c < MALLOC_CACHE_CLASSES; c++)
+    {
+	chunk_t *r;
+
+	while ((r = __malloc_cache[c]) != NULL)
+	{
+	    __malloc_cache[c] = r->next;
+	    r->next = list;
+	    list = r;
+	}
+	__malloc_cache_count[c] = 0;
+    }
+    if (list)
+	__malloc_cache_release(list);
+}
+#endif /* _NANO_MALLOC_THREAD_CACHE */
+
+/** Function free
+  * Implementation of libc free.
+  * Algorithm:
+  *  Keep small chunks in the thread cache when enabled, otherwise
+  *  return the chunk to the shared pool.
+  */
+#ifdef _NANO_MALLOC_STATS
+void __malloc_free (void * free_p)
+#else
+void free (void * free_p)
+#endif
+{
+    chunk_t * p_to_free;
+
+    if (free_p == NULL) return;
+
+    p_to_free = ptr_to_chunk(free_p);
+#if MALLOC_DEBUG
+    __malloc_validate_block(p_to_free);
+#endif
+
+    stats_update(chunk_get_size(p_to_free), 0);
+
+#ifdef _NANO_MALLOC_THREAD_CACHE
+    size_t size = chunk_get_size(p_to_free);
+
+    if (size <= MALLOC_CACHE_MAX)
+    {
+	unsigned c = (size - MALLOC_MINSIZE) / MALLOC_CHUNK_ALIGN;
+
+	/* When full, hand the least recently freed batch back */
+	if (__malloc_cache_count[c] >= MALLOC_CACHE_DEPTH)
+	{
+	    chunk_t **p = &__malloc_cache[c];
+	    chunk_t *list;
+	    unsigned keep;
+
+	    for (keep = MALLOC_CACHE_DEPTH - MALLOC_CACHE_BATCH; keep; keep--)
+		p = &(*p)->next;
+	    list = *p;
+	    *p = NULL;
+	    __malloc_cache_count[c] = MALLOC_CACHE_DEPTH - MALLOC_CACHE_BATCH;
+	    __malloc_cache_release(list);
+	}
+	p_to_free->next = __malloc_cache[c];
+	__malloc_cache[c] = p_to_free;
+	__malloc_cache_count[c]++;
+	return;
+    }
+#endif
+
+    MALLOC_LOCK;
+    __malloc_put_chunk(p_to_free);
+    MALLOC_UNLOCK;
+}
+#ifdef _NANO_MALLOC_STATS
+void free (void * free_p)
+{
+    if (free_p == NULL) return;
+
+    MALLOC_HOOK(__malloc_free_hook, free_p, chunk_usable(ptr_to_chunk(free_p)));
+    __malloc_free(free_p);
+}
+#endif
 #ifdef HAVE_ALIAS_ATTRIBUTE
 #pragma GCC diagnostic push
 #ifndef __clang__
 #pragma GCC diagnostic ignored "-Wmissing-attributes"
 #endif
+#ifndef _NANO_MALLOC_STATS
 __strong_reference(free, __malloc_free);
+#endif
 __strong_reference(free, cfree);
 #pragma GCC diagnostic pop
 #endif
@@ -490,10 +1167,19 @@ void * calloc(size_t n, size_t elem)
 
     if (mul_overflow (n, elem, &bytes))
     {
+        stats_failed();
         errno = ENOMEM;
         return NULL;
     }
+#ifdef _NANO_MALLOC_STATS
+    void *ptr = __malloc_malloc(bytes);
+
+    if (ptr)
+	MALLOC_HOOK(__malloc_alloc_hook, ptr, bytes);
+    return ptr;
+#else
     return malloc(bytes);
+#endif
 }
 #endif /* DEFINE_CALLOC */
 
@@ -504,16 +1190,20 @@ void * calloc(size_t n, size_t elem)
  * Implement either by merging adjacent free memory
  * or by calling malloc/memcpy
  */
+#ifdef _NANO_MALLOC_STATS
+static void * __malloc_realloc(void * ptr, size_t size)
+#else
 void * realloc(void * ptr, size_t size)
+#endif
 {
     void * mem;
 
     if (ptr == NULL)
-	return malloc(size);
+	return __malloc_malloc(size);
 
     if (size == 0)
     {
-        free(ptr);
+        __malloc_free(ptr);
         return NULL;
     }
 
@@ -524,7 +1214,8 @@ void * realloc(void * ptr, size_t size)
     __malloc_validate_block(p_to_realloc);
 #endif
 
-    size_t old_size = p_to_realloc->size;
+    size_t old_size = chunk_get_size(p_to_realloc);
+    size_t orig_size = old_size;
 
     /* See if we can avoid allocating new memory
      * when increasing the size
@@ -544,6 +1235,26 @@ void * realloc(void * ptr, size_t size)
 	}
 	else
 	{
+#ifdef _NANO_MALLOC_SEGREGATED
+	    chunk_t *r = chunk_e;
+
+	    /* Merge in the chunk just past the current block if free */
+	    if (chunk_is_free(r))
+	    {
+		size_t r_size = chunk_get_size(r);
+
+		/* remove R from the free bins */
+		bin_remove(r);
+		((chunk_t *) chunk_end(r))->size &= ~MALLOC_PREV_FREE;
+
+		/* clear the memory from r */
+		memset(r, '\0', r_size);
+
+		/* add it's size to our block */
+		old_size += r_size;
+		chunk_set_size(p_to_realloc, old_size);
+	    }
+#else
 	    chunk_t **p, *r;
 
 	    /* Check to see if there's a chunk_t of free space just past
@@ -557,6 +1268,7 @@ void * realloc(void * ptr, size_t size)
 
 		    /* remove R from the free list */
 		    *p = r->next;
+		    stats_free_remove(r_size);
 
 		    /* clear the memory from r */
 		    memset(r, '\0', r_size);
@@ -569,6 +1281,7 @@ void * realloc(void * ptr, size_t size)
 		if (p_to_realloc < r)
 		    break;
 	    }
+#endif
 	}
 
 	MALLOC_UNLOCK;
@@ -578,11 +1291,14 @@ void * realloc(void * ptr, size_t size)
     {
 	size_t extra = old_size - new_size;
 
+	stats_update(orig_size, old_size);
+
 	/* If there's enough space left over, split it out
 	 * and free it
 	 */
 	if (extra >= MALLOC_MINSIZE) {
-	    p_to_realloc->size = new_size;
+	    stats_split(old_size, extra);
+	    chunk_set_size(p_to_realloc, new_size);
 	    make_free_chunk(chunk_end(p_to_realloc), extra);
 	}
 	return ptr;
@@ -590,12 +1306,27 @@ void * realloc(void * ptr, size_t size)
 
     /* No short cuts, allocate new memory and copy */
 
-    mem = malloc(size);
+    mem = __malloc_malloc(size);
     memcpy(mem, ptr, old_size - MALLOC_HEAD);
-    free(ptr);
+    __malloc_free(ptr);
 
     return mem;
 }
+
+#ifdef _NANO_MALLOC_STATS
+void * realloc(void * ptr, size_t size)
+{
+    size_t old_usable = ptr ? chunk_usable(ptr_to_chunk(ptr)) : 0;
+    void * mem = __malloc_realloc(ptr, size);
+
+    /* On failure, the original block remains allocated */
+    if (ptr && (mem || size == 0))
+	MALLOC_HOOK(__malloc_free_hook, ptr, old_usable);
+    if (mem)
+	MALLOC_HOOK(__malloc_alloc_hook, mem, size);
+    return mem;
+}
+#endif
 #endif /* DEFINE_REALLOC */
 
 #ifdef DEFINE_MALLINFO
@@ -608,9 +1339,9 @@ __malloc_validate_block(chunk_t *r)
     __malloc_block = r;
     assert (ALIGN_PTR(chunk_to_ptr(r), MALLOC_CHUNK_ALIGN) == chunk_to_ptr(r));
     assert (ALIGN_PTR(r, MALLOC_HEAD_ALIGN) == r);
-    assert (r->size >= MALLOC_MINSIZE);
-    assert (r->size < 0x80000000UL);
-    assert (ALIGN_TO(r->size, MALLOC_HEAD_ALIGN) == r->size);
+    assert (chunk_get_size(r) >= MALLOC_MINSIZE);
+    assert (chunk_get_size(r) < 0x80000000UL);
+    assert (ALIGN_TO(chunk_get_size(r), MALLOC_HEAD_ALIGN) == chunk_get_size(r));
 }
 
 void
@@ -618,10 +1349,27 @@ __malloc_validate(void)
 {
     chunk_t *r;
 
+#ifdef _NANO_MALLOC_SEGREGATED
+    unsigned b;
+
+    for (b = 0; b < MALLOC_NBINS; b++) {
+	assert (((__malloc_bin_map >> b) & 1) == (__malloc_bins[b] != NULL));
+	for (r = __malloc_bins[b]; r; r = r->next) {
+	    __malloc_validate_block(r);
+	    assert (chunk_bin(r->size) == b);
+	    assert ((r->size & MALLOC_PREV_FREE) == 0);
+	    assert (((size_t *) chunk_end(r))[-1] == r->size);
+	    assert (chunk_is_free(r));
+	    assert (!chunk_is_free(chunk_end(r)));
+	    assert (r->next == NULL || r->next->prev == r);
+	}
+    }
+#else
     for (r = __malloc_free_list; r; r = r->next) {
 	__malloc_validate_block(r);
 	assert (r->next == NULL || (char *) r + r->size < (char *) r->next);
     }
+#endif
 }
 
 struct mallinfo mallinfo(void)
@@ -633,6 +1381,11 @@ struct mallinfo mallinfo(void)
     int ordblks = 0;
     struct mallinfo current_mallinfo;
 
+#ifdef _NANO_MALLOC_THREAD_CACHE
+    /* Count cached chunks as free */
+    __malloc_cache_flush();
+#endif
+
     MALLOC_LOCK;
 
     __malloc_validate();
@@ -647,10 +1400,20 @@ struct mallinfo mallinfo(void)
             total_size = (size_t) (sbrk_now - __malloc_sbrk_start);
     }
 
+#ifdef _NANO_MALLOC_SEGREGATED
+    unsigned b;
+
+    for (b = 0; b < MALLOC_NBINS; b++)
+	for (pf = __malloc_bins[b]; pf; pf = pf->next) {
+	    ordblks++;
+	    free_size += pf->size;
+	}
+#else
     for (pf = __malloc_free_list; pf; pf = pf->next) {
 	ordblks++;
         free_size += pf->size;
     }
+#endif
 
     current_mallinfo.ordblks = ordblks;
     current_mallinfo.arena = total_size;
@@ -680,6 +1443,39 @@ void malloc_stats(void)
 }
 #endif /* DEFINE_MALLOC_STATS */
 
+#ifdef DEFINE_MALLSTATS
+#ifdef _NANO_MALLOC_STATS
+
+mallstats_hook_t __malloc_alloc_hook;
+mallstats_hook_t __malloc_free_hook;
+
+/* Function mallstats
+ *
+ * Copy the running counters without taking the malloc lock
+ */
+void mallstats(struct mallstats *stats)
+{
+    unsigned c;
+
+    stats->in_use = __atomic_load_n(&__malloc_stats.in_use, __ATOMIC_RELAXED);
+    stats->max_in_use = __atomic_load_n(&__malloc_stats.max_in_use, __ATOMIC_RELAXED);
+    stats->arena = __atomic_load_n(&__malloc_stats.arena, __ATOMIC_RELAXED);
+    stats->largest_free = __atomic_load_n(&__malloc_stats.largest_free, __ATOMIC_RELAXED);
+    stats->sbrk_calls = __atomic_load_n(&__malloc_stats.sbrk_calls, __ATOMIC_RELAXED);
+    stats->failed = __atomic_load_n(&__malloc_stats.failed, __ATOMIC_RELAXED);
+    for (c = 0; c < MALLSTATS_CLASSES; c++)
+	stats->count[c] = __atomic_load_n(&__malloc_stats.count[c], __ATOMIC_RELAXED);
+}
+
+void mallstats_set_hooks(mallstats_hook_t alloc_hook, mallstats_hook_t free_hook)
+{
+    __atomic_store_n(&__malloc_alloc_hook, alloc_hook, __ATOMIC_RELAXED);
+    __atomic_store_n(&__malloc_free_hook, free_hook, __ATOMIC_RELAXED);
+}
+
+#endif /* _NANO_MALLOC_STATS */
+#endif /* DEFINE_MALLSTATS */
+
 #ifdef DEFINE_MALLOC_USABLE_SIZE
 size_t malloc_usable_size(void * ptr)
 {
@@ -705,11 +1501,15 @@ void * memalign(size_t align, size_t s)
     chunk_t * chunk_p;
     size_t offset, size_with_padding;
     char * allocated, * aligned_p;
+#ifdef _NANO_MALLOC_STATS
+    size_t request = s;
+#endif
 
     /* Return NULL if align isn't power of 2 */
     if ((align & (align-1)) != 0) return NULL;
 
-    s = ALIGN_TO(MAX(s,1), MALLOC_CHUNK_ALIGN);
+    /* Make sure the aligned chunk can hold a free chunk */
+    s = ALIGN_TO(MAX(s, MALLOC_MINSIZE - MALLOC_HEAD), MALLOC_CHUNK_ALIGN);
     align = MAX(align, MALLOC_MINSIZE);
 
     /* Make sure there's space to align the allocation and split
@@ -735,22 +1535,30 @@ void * memalign(size_t align, size_t s)
 	}
 
 	chunk_t *new_chunk_p = ptr_to_chunk(aligned_p);
-	new_chunk_p->size = chunk_p->size - offset;
+	new_chunk_p->size = chunk_get_size(chunk_p) - offset;
+
+	stats_split(chunk_get_size(chunk_p), chunk_get_size(chunk_p) - offset);
 
-	make_free_chunk(chunk_p, offset);
+	/* Keep any flags in the original header */
+	chunk_set_size(chunk_p, offset);
+	__malloc_free(allocated);
 
 	chunk_p = new_chunk_p;
     }
 
-    offset = chunk_p->size - chunk_size(s);
+    offset = chunk_get_size(chunk_p) - chunk_size(s);
 
     /* Split off the back piece if large enough */
     if (offset >= MALLOC_MINSIZE)
     {
-	chunk_p->size -= offset;
+	stats_split(chunk_get_size(chunk_p), offset);
+	chunk_set_size(chunk_p, chunk_get_size(chunk_p) - offset);
 
 	make_free_chunk((chunk_t *) chunk_end(chunk_p), offset);
     }
+#ifdef _NANO_MALLOC_STATS
+    MALLOC_HOOK(__malloc_alloc_hook, aligned_p, request);
+#endif
     return aligned_p;
 }
 #ifdef HAVE_ALIAS_ATTRIBUTE
@@ -27,6 +27,62 @@ No supporting OS subroutine calls are required.
 */
 
 #include <stdlib.h>
+#include <limits.h>
+
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+#define UTOA_DECIMAL_PAIRS
+
+/* Digits of each value from 0 to 99 */
+static const char utoa_pairs[200] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const unsigned utoa_pow10[] = {
+  1, 10, 100, 1000, 10000,
+#if UINT_MAX > 0xffff
+  100000, 1000000, 10000000, 100000000, 1000000000,
+#endif
+};
+
+/* Decimal conversion two digits at a time, writing from the end
+   after counting the digits without a loop */
+static char *
+__utoa_decimal (unsigned value,
+                char *str)
+{
+  unsigned bits = sizeof (unsigned) * CHAR_BIT - __builtin_clz (value | 1);
+  unsigned ndigits = (bits * 1233) >> 12;
+  char *end;
+
+  ndigits += (value | 1) >= utoa_pow10[ndigits];
+  end = str + ndigits;
+  *end = '\0';
+  while (value >= 100)
+    {
+      unsigned q = value / 100;
+      end -= 2;
+      end[0] = utoa_pairs[(value - q * 100) * 2];
+      end[1] = utoa_pairs[(value - q * 100) * 2 + 1];
+      value = q;
+    }
+  if (value >= 10)
+    {
+      end[-2] = utoa_pairs[value * 2];
+      end[-1] = utoa_pairs[value * 2 + 1];
+    }
+  else
+    end[-1] = '0' + value;
+  return str;
+}
+#endif
 
 char *
 __utoa (unsigned value,
@@ -44,6 +100,11 @@ __utoa (unsigned value,
       str[0] = '\0';
       return NULL;
     }  
+
+#ifdef UTOA_DECIMAL_PAIRS
+  if (base == 10)
+    return __utoa_decimal (value, str);
+#endif
     
   /* Convert to string. Digits are in reverse order.  */
   i = 0;
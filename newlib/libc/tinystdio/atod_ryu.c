@@ -60,9 +60,133 @@ static inline double int64Bits2Double(uint64_t bits) {
   return f;
 }
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+
+#define ATOD_POW5_MIN	-64
+#define ATOD_POW5_MAX	63
+
+/*
+ * Top 64 bits of 5^q for the exponents found in most input, q from
+ * ATOD_POW5_MIN to ATOD_POW5_MAX. Negative powers are computed as
+ * 2^(pow5bits(-q)+63) / 5^-q, matching __double_computeInvPow5.
+ */
+static const uint64_t atod_pow5[ATOD_POW5_MAX - ATOD_POW5_MIN + 1] = {
+    0xa87fea27a539e9a5ull, 0xd29fe4b18e88640eull, 0x83a3eeeef9153e89ull,
+    0xa48ceaaab75a8e2bull, 0xcdb02555653131b6ull, 0x808e17555f3ebf11ull,
+    0xa0b19d2ab70e6ed6ull, 0xc8de047564d20a8bull, 0xfb158592be068d2eull,
+    0x9ced737bb6c4183dull, 0xc428d05aa4751e4cull, 0xf53304714d9265dfull,
+    0x993fe2c6d07b7fabull, 0xbf8fdb78849a5f96ull, 0xef73d256a5c0f77cull,
+    0x95a8637627989aadull, 0xbb127c53b17ec159ull, 0xe9d71b689dde71afull,
+    0x9226712162ab070dull, 0xb6b00d69bb55c8d1ull, 0xe45c10c42a2b3b05ull,
+    0x8eb98a7a9a5b04e3ull, 0xb267ed1940f1c61cull, 0xdf01e85f912e37a3ull,
+    0x8b61313bbabce2c6ull, 0xae397d8aa96c1b77ull, 0xd9c7dced53c72255ull,
+    0x881cea14545c7575ull, 0xaa242499697392d2ull, 0xd4ad2dbfc3d07787ull,
+    0x84ec3c97da624ab4ull, 0xa6274bbdd0fadd61ull, 0xcfb11ead453994baull,
+    0x81ceb32c4b43fcf4ull, 0xa2425ff75e14fc31ull, 0xcad2f7f5359a3b3eull,
+    0xfd87b5f28300ca0dull, 0x9e74d1b791e07e48ull, 0xc612062576589ddaull,
+    0xf79687aed3eec551ull, 0x9abe14cd44753b52ull, 0xc16d9a0095928a27ull,
+    0xf1c90080baf72cb1ull, 0x971da05074da7beeull, 0xbce5086492111aeaull,
+    0xec1e4a7db69561a5ull, 0x9392ee8e921d5d07ull, 0xb877aa3236a4b449ull,
+    0xe69594bec44de15bull, 0x901d7cf73ab0acd9ull, 0xb424dc35095cd80full,
+    0xe12e13424bb40e13ull, 0x8cbccc096f5088cbull, 0xafebff0bcb24aafeull,
+    0xdbe6fecebdedd5beull, 0x89705f4136b4a597ull, 0xabcc77118461cefcull,
+    0xd6bf94d5e57a42bcull, 0x8637bd05af6c69b5ull, 0xa7c5ac471b478423ull,
+    0xd1b71758e219652bull, 0x83126e978d4fdf3bull, 0xa3d70a3d70a3d70aull,
+    0xccccccccccccccccull, 0x8000000000000000ull, 0xa000000000000000ull,
+    0xc800000000000000ull, 0xfa00000000000000ull, 0x9c40000000000000ull,
+    0xc350000000000000ull, 0xf424000000000000ull, 0x9896800000000000ull,
+    0xbebc200000000000ull, 0xee6b280000000000ull, 0x9502f90000000000ull,
+    0xba43b74000000000ull, 0xe8d4a51000000000ull, 0x9184e72a00000000ull,
+    0xb5e620f480000000ull, 0xe35fa931a0000000ull, 0x8e1bc9bf04000000ull,
+    0xb1a2bc2ec5000000ull, 0xde0b6b3a76400000ull, 0x8ac7230489e80000ull,
+    0xad78ebc5ac620000ull, 0xd8d726b7177a8000ull, 0x878678326eac9000ull,
+    0xa968163f0a57b400ull, 0xd3c21bcecceda100ull, 0x84595161401484a0ull,
+    0xa56fa5b99019a5c8ull, 0xcecb8f27f4200f3aull, 0x813f3978f8940984ull,
+    0xa18f07d736b90be5ull, 0xc9f2c9cd04674edeull, 0xfc6f7c4045812296ull,
+    0x9dc5ada82b70b59dull, 0xc5371912364ce305ull, 0xf684df56c3e01bc6ull,
+    0x9a130b963a6c115cull, 0xc097ce7bc90715b3ull, 0xf0bdc21abb48db20ull,
+    0x96769950b50d88f4ull, 0xbc143fa4e250eb31ull, 0xeb194f8e1ae525fdull,
+    0x92efd1b8d0cf37beull, 0xb7abc627050305adull, 0xe596b7b0c643c719ull,
+    0x8f7e32ce7bea5c6full, 0xb35dbf821ae4f38bull, 0xe0352f62a19e306eull,
+    0x8c213d9da502de45ull, 0xaf298d050e4395d6ull, 0xdaf3f04651d47b4cull,
+    0x88d8762bf324cd0full, 0xab0e93b6efee0053ull, 0xd5d238a4abe98068ull,
+    0x85a36366eb71f041ull, 0xa70c3c40a64e6c51ull, 0xd0cf4b50cfe20765ull,
+    0x82818f1281ed449full, 0xa321f2d7226895c7ull, 0xcbea6f8ceb02bb39ull,
+    0xfee50b7025c36a08ull, 0x9f4f2726179a2245ull, 0xc722f0ef9d80aad6ull,
+    0xf8ebad2b84e0d58bull, 0x9b934c3b330c8577ull
+};
+
+/* pow5bits, inline */
+static inline int32_t atod_pow5bits(int32_t e) {
+    return (int32_t) ((((uint32_t) e) * 1217359) >> 19) + 1;
+}
+
+/*
+ * Eisel-Lemire fast path. Multiply the normalized decimal mantissa
+ * by the top 64 bits of 5^e10, from the table above or rebuilt from
+ * the compact Ryu tables. Those bits are within one unit of the true value, so
+ * the high word of the product is within one unit too. When the bits
+ * below the rounding bit are neither all zeros nor all ones, that
+ * error can't change the rounded result, which can't be a tie
+ * either. Everything else, including subnormal and overflowing
+ * results, goes to the exact code.
+ */
+static bool
+atod_fast(uint64_t m10, int e10, double *result)
+{
+    uint64_t t;
+    int32_t e2;
+
+    if (e10 >= 0)
+	e2 = e10 + atod_pow5bits(e10) - 64;
+    else
+	e2 = e10 - atod_pow5bits(-e10) - 63;
+
+    if (ATOD_POW5_MIN <= e10 && e10 <= ATOD_POW5_MAX) {
+	t = atod_pow5[e10 - ATOD_POW5_MIN];
+    } else {
+	uint64_t pow5[2];
+	if (e10 >= 0)
+	    __double_computePow5(e10, pow5);
+	else
+	    __double_computeInvPow5(-e10, pow5);
+	t = (pow5[1] << 3) | (pow5[0] >> 61);
+    }
+
+    int32_t lz = 63 - floor_log2(m10);
+    uint64_t hi;
+    umul128(m10 << lz, t, &hi);
+
+    uint32_t upper = (uint32_t) (hi >> 63);
+    uint32_t shift = upper + 9;
+    uint64_t mask = (1ull << shift) - 1;
+    if ((hi & mask) == 0 || (hi & mask) == mask)
+	return false;
+
+    uint64_t ieee_m2 = hi >> shift;
+    ieee_m2 = (ieee_m2 + (ieee_m2 & 1)) >> 1;
+    int32_t ieee_e2 = e2 - lz + shift + 65 + DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BIAS;
+    if (ieee_m2 == (1ull << (DOUBLE_MANTISSA_BITS + 1))) {
+	ieee_m2 >>= 1;
+	ieee_e2++;
+    }
+    if (ieee_e2 <= 0 || ieee_e2 >= 0x7ff)
+	return false;
+
+    ieee_m2 &= (1ull << DOUBLE_MANTISSA_BITS) - 1;
+    *result = int64Bits2Double((((uint64_t)ieee_e2) << DOUBLE_MANTISSA_BITS) | ieee_m2);
+    return true;
+}
+#endif
+
 double
 __atod_engine(uint64_t m10, int e10)
 {
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+    double result;
+    if (atod_fast(m10, e10, &result))
+	return result;
+#endif
 #ifdef RYU_DEBUG
     printf("Input=%s\n", buffer);
     printf("m10digits = %d\n", m10digits);
@@ -107,7 +231,9 @@ __atod_engine(uint64_t m10, int e10)
 	uint64_t pow5[2];
 	__double_computeInvPow5(-e10, pow5);
 	m2 = mulShift64(m10, pow5, j);
-	trailingZeros = multipleOfPowerOf5(m10, -e10);
+	// The result is exact only if both 5^-e10 and 2^(e2-e10) divide m10.
+	trailingZeros = (e2 <= e10 || (e2 - e10 < 64 && multipleOfPowerOf2(m10, e2 - e10))) &&
+	    multipleOfPowerOf5(m10, -e10);
     }
 
 #ifdef RYU_DEBUG
@@ -147,11 +273,13 @@ __atod_engine(uint64_t m10, int e10)
     printf("ieee_m2 = %" PRIu64 "\n", (m2 >> shift) + roundUp);
 #endif
     uint64_t ieee_m2 = (m2 >> shift) + roundUp;
-    if (ieee_m2 == (1ull << (DOUBLE_MANTISSA_BITS + 1))) {
+    ieee_m2 &= (1ull << DOUBLE_MANTISSA_BITS) - 1;
+    if (ieee_m2 == 0 && roundUp) {
+	// Rounding up may overflow the mantissa, or carry a subnormal into the smallest
+	// normal. In either case, move a trailing zero of the mantissa into the exponent.
 	// Due to how the IEEE represents +/-Infinity, we don't need to check for overflow here.
 	ieee_e2++;
     }
-    ieee_m2 &= (1ull << DOUBLE_MANTISSA_BITS) - 1;
     uint64_t ieee = (((uint64_t)ieee_e2) << DOUBLE_MANTISSA_BITS) | ieee_m2;
     return int64Bits2Double(ieee);
 }
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <float.h>
 
 #ifdef RYU_DEBUG
 #include <inttypes.h>
@@ -59,9 +60,37 @@ static inline float int32Bits2Float(uint32_t bits) {
   return f;
 }
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__) && FLT_EVAL_METHOD == 0
+#define ATOF_FAST
+
+/*
+ * Powers of ten which are exact in a float: 5^10 < 2^24
+ */
+static const float atof_pow10[] = {
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+#define ATOF_POW10_MAX	((int) (sizeof(atof_pow10) / sizeof(atof_pow10[0])) - 1)
+#endif
+
 float
 __atof_engine(uint32_t m10, int e10)
 {
+#ifdef ATOF_FAST
+	/*
+	 * When both the mantissa and the power of ten are exact, a
+	 * single IEEE multiply or divide gives the correctly rounded
+	 * result (Clinger's fast path).
+	 */
+	if (m10 < (1ul << (FLOAT_MANTISSA_BITS + 1)) &&
+	    -ATOF_POW10_MAX <= e10 && e10 <= ATOF_POW10_MAX)
+	{
+		float f = (float) m10;
+		if (e10 < 0)
+			return f / atof_pow10[-e10];
+		return f * atof_pow10[e10];
+	}
+#endif
 #ifdef RYU_DEBUG
 	printf("Input=%s\n", buffer);
 	printf("m10digits = %d\n", m10digits);
@@ -102,7 +131,9 @@ __atof_engine(uint32_t m10, int e10)
 		e2 = floor_log2(m10) + e10 - ceil_log2pow5(-e10) - (FLOAT_MANTISSA_BITS + 1);
 		int j = e2 - e10 + ceil_log2pow5(-e10) - 1 + FLOAT_POW5_INV_BITCOUNT;
 		m2 = mulPow5InvDivPow2(m10, -e10, j);
-		trailingZeros = multipleOfPowerOf5_32(m10, -e10);
+		// The result is exact only if both 5^-e10 and 2^(e2-e10) divide m10.
+		trailingZeros = (e2 <= e10 || (e2 - e10 < 32 && multipleOfPowerOf2_32(m10, e2 - e10))) &&
+			multipleOfPowerOf5_32(m10, -e10);
 	}
 
 #ifdef RYU_DEBUG
@@ -142,11 +173,13 @@ __atof_engine(uint32_t m10, int e10)
 	printf("ieee_m2 = %u\n", (m2 >> shift) + roundUp);
 #endif
 	uint32_t ieee_m2 = (m2 >> shift) + roundUp;
-	if (ieee_m2 == (1u << (FLOAT_MANTISSA_BITS + 1))) {
+	ieee_m2 &= (1u << FLOAT_MANTISSA_BITS) - 1;
+	if (ieee_m2 == 0 && roundUp) {
+		// Rounding up may overflow the mantissa, or carry a subnormal into the smallest
+		// normal. In either case, move a trailing zero of the mantissa into the exponent.
 		// Due to how the IEEE represents +/-Infinity, we don't need to check for overflow here.
 		ieee_e2++;
 	}
-	ieee_m2 &= (1u << FLOAT_MANTISSA_BITS) - 1;
 	uint32_t ieee = (((uint32_t)ieee_e2) << FLOAT_MANTISSA_BITS) | ieee_m2;
 	return int32Bits2Float(ieee);
 }
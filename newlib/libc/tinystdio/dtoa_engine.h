@@ -87,6 +87,9 @@ struct dtoa {
 int
 __dtoa_engine(FLOAT x, struct dtoa *dtoa, int max_digits, int max_decimals);
 
+int
+__dtoa_to_chars(char *buf, size_t size, const char *digits, int ndigit, int exp, int flags);
+
 extern NEWLIB_THREAD_LOCAL char __ecvt_buf[DTOA_MAX_DIG + 1];
 
 extern const FLOAT __dtoa_scale_up[];
@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dtoa_engine.h"
+#include <string.h>
+
+static inline void
+__dtoa_put(char *buf, size_t size, size_t *len, char c)
+{
+	if (*len + 1 < size)
+		buf[*len] = c;
+	(*len)++;
+}
+
+/*
+ * Format the digit string generated by one of the float/string
+ * engines in whichever of fixed or scientific notation is shorter,
+ * preferring fixed notation when they are the same length. This
+ * matches the C++ std::to_chars 'plain' format, with the exponent
+ * written the same way printf does. Like snprintf, the result is
+ * truncated to fit 'size' and the untruncated length is returned.
+ */
+int
+__dtoa_to_chars(char *buf, size_t size, const char *digits, int ndigit, int exp, int flags)
+{
+	size_t	len = 0;
+	int	i;
+
+	if (flags & DTOA_MINUS)
+		__dtoa_put(buf, size, &len, '-');
+
+	if (flags & (DTOA_NAN|DTOA_INF)) {
+		const char *s = (flags & DTOA_NAN) ? "nan" : "inf";
+		while (*s)
+			__dtoa_put(buf, size, &len, *s++);
+	} else {
+		int	aexp = exp < 0 ? -exp : exp;
+		int	ewidth = aexp >= 100 ? 3 : 2;
+		int	sci_len, fixed_len;
+
+		/* The non-exact engines pad to the requested precision */
+		while (ndigit > 1 && digits[ndigit-1] == '0')
+			ndigit--;
+
+		sci_len = ndigit + (ndigit > 1) + 2 + ewidth;
+		if (exp < 0)
+			fixed_len = ndigit + 1 - exp;
+		else if (ndigit <= exp + 1)
+			fixed_len = exp + 1;
+		else
+			fixed_len = ndigit + 1;
+
+		if (fixed_len <= sci_len) {
+			if (exp < 0) {
+				__dtoa_put(buf, size, &len, '0');
+				__dtoa_put(buf, size, &len, '.');
+				for (i = exp + 1; i < 0; i++)
+					__dtoa_put(buf, size, &len, '0');
+				for (i = 0; i < ndigit; i++)
+					__dtoa_put(buf, size, &len, digits[i]);
+			} else {
+				int	n = ndigit > exp + 1 ? ndigit : exp + 1;
+				for (i = 0; i < n; i++) {
+					if (i == exp + 1)
+						__dtoa_put(buf, size, &len, '.');
+					__dtoa_put(buf, size, &len, i < ndigit ? digits[i] : '0');
+				}
+			}
+		} else {
+			__dtoa_put(buf, size, &len, digits[0]);
+			if (ndigit > 1) {
+				__dtoa_put(buf, size, &len, '.');
+				for (i = 1; i < ndigit; i++)
+					__dtoa_put(buf, size, &len, digits[i]);
+			}
+			__dtoa_put(buf, size, &len, 'e');
+			__dtoa_put(buf, size, &len, exp < 0 ? '-' : '+');
+			if (ewidth == 3)
+				__dtoa_put(buf, size, &len, '0' + aexp / 100);
+			__dtoa_put(buf, size, &len, '0' + (aexp / 10) % 10);
+			__dtoa_put(buf, size, &len, '0' + aexp % 10);
+		}
+	}
+	if (size)
+		buf[len < size ? len : size - 1] = '\0';
+	return (int) len;
+}
@@ -38,46 +38,40 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-static inline int
-has_mode(int flags, int mode)
-{
-	return (flags & mode) ? 1 : 0;
-}
-
 FILE *
 fdopen(int fd, const char *mode)
 {
 	int stdio_flags;
 	int open_flags;
 	struct __file_posix *pf;
-	char *buf;
 
 	stdio_flags = __posix_sflags(mode, &open_flags);
 	if (stdio_flags == 0)
 		return NULL;
 
-	/* Allocate file structure and necessary buffers */
-	pf = calloc(1, sizeof(struct __file_posix) +
-		    BUFSIZ * (has_mode(stdio_flags, __SRD) + has_mode(stdio_flags, __SWR)));
+	/* Allocate file structure; buffers are allocated on first use */
+	pf = calloc(1, sizeof(struct __file_posix));
 	if (pf == NULL) {
 		close(fd);
 		return NULL;
 	}
-	buf = (char *) pf + sizeof (*pf);
 
 	pf->cfile.file.flags = stdio_flags | __SCLOSE;
 	pf->cfile.close = __posix_close;
+	pf->cfile.seek = __posix_seek;
 	pf->fd = fd;
 	if (stdio_flags & __SWR) {
 		pf->cfile.file.put = __posix_putc;
+		pf->cfile.file.write = __posix_write;
 		pf->cfile.file.flush = __posix_flush;
-		pf->write_buf = buf;
-		buf += BUFSIZ;
 	}
 	if (stdio_flags & __SRD) {
 		pf->cfile.file.get = __posix_getc;
-		pf->read_buf = buf;
+		pf->cfile.file.read = __posix_read;
 	}
+	pf->buf_size = BUFSIZ;
+	/* stdin/stdout/stderr are line buffered, the rest fully buffered */
+	pf->buf_mode = fd <= 2 ? _IOLBF : _IOFBF;
 
 	if (open_flags & O_APPEND)
 		(void) lseek(fd, 0, SEEK_END);
@@ -34,6 +34,7 @@
  */
 
 #include "stdio_private.h"
+#include <string.h>
 
 int
 __file_str_put(char c, FILE *stream)
@@ -45,3 +46,20 @@ __file_str_put(char c, FILE *stream)
 	++sstream->len;
 	return c;
 }
+
+__ssize_t
+__file_str_write(FILE *stream, const void *buf, size_t len)
+{
+	struct __file_str *sstream = (struct __file_str *) stream;
+	size_t avail;
+
+	if (sstream->len >= sstream->size)
+		return 0;
+	avail = sstream->size - sstream->len;
+	if (len > avail)
+		len = avail;
+	memcpy(sstream->buf, buf, len);
+	sstream->buf += len;
+	sstream->len += len;
+	return len;
+}
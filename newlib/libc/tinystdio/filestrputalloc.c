@@ -34,7 +34,9 @@
  */
 
 #include "stdio_private.h"
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 int
 __file_str_put_alloc(char c, FILE *stream)
@@ -50,3 +52,26 @@ __file_str_put_alloc(char c, FILE *stream)
 	sstream->buf[sstream->len++] = c;
 	return c;
 }
+
+__ssize_t
+__file_str_write_alloc(FILE *stream, const void *buf, size_t len)
+{
+	struct __file_str *sstream = (struct __file_str *) stream;
+	size_t need = (size_t) sstream->len + len;
+
+	if (need > (size_t) sstream->size) {
+		size_t size = (need + 31) & ~(size_t) 31;
+		char *new;
+
+		if (size > INT_MAX)
+			return EOF;
+		new = realloc(sstream->buf, size);
+		if (!new)
+			return EOF;
+		sstream->size = size;
+		sstream->buf = new;
+	}
+	memcpy(sstream->buf + sstream->len, buf, len);
+	sstream->len += len;
+	return len;
+}
@@ -31,19 +31,19 @@
 
 #include <stdio.h>
 #include "stdio_private.h"
+#include <string.h>
 
 int
 fputs(const char *str, FILE *stream)
 {
-	char c;
-	int rv = 0;
+	size_t len;
 
 	if ((stream->flags & __SWR) == 0)
 		return EOF;
 
-	while ((c = *str++) != '\0')
-		if (stream->put(c, stream) != 0)
-			rv = EOF;
+	len = strlen(str);
+	if (__file_write(stream, str, len) != len)
+		return EOF;
 
-	return rv;
+	return 0;
 }
@@ -39,9 +39,34 @@ fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
 	uint8_t *cp;
 	int c;
 
-	if ((stream->flags & __SRD) == 0)
+	if ((stream->flags & __SRD) == 0 || size == 0)
 		return 0;
 
+	if (stream->read) {
+		size_t len, done = 0;
+		__ssize_t ret;
+		__ungetc_t unget;
+
+		if (nmemb > SIZE_MAX / size)
+			nmemb = SIZE_MAX / size;
+		len = size * nmemb;
+		cp = ptr;
+
+		/* Pick up any pushed-back character first */
+		if (len && (unget = __atomic_exchange_ungetc(&stream->unget, 0)) != 0)
+			cp[done++] = (uint8_t) unget;
+
+		while (done < len) {
+			ret = (*stream->read)(stream, cp + done, len - done);
+			if (ret <= 0) {
+				stream->flags |= (ret < 0) ? __SERR : __SEOF;
+				break;
+			}
+			done += ret;
+		}
+		return done / size;
+	}
+
 	for (i = 0, cp = (uint8_t *)ptr; i < nmemb; i++)
 		for (j = 0; j < size; j++) {
 			c = getc(stream);
@@ -34,13 +34,8 @@
  */
 
 #include <stdio.h>
-#include <errno.h>
 
 int fseek(FILE *stream, long offset, int whence)
 {
-	(void) stream;
-	(void) offset;
-	(void) whence;
-	errno = ESPIPE;
-	return -1;
+	return fseeko(stream, (off_t) offset, whence);
 }
@@ -34,10 +34,16 @@
  */
 
 #include <stdio.h>
+#include <errno.h>
 
 long
 ftell(FILE *stream)
 {
-	(void) stream;
-	return 0;
+	off_t pos = ftello(stream);
+
+	if ((off_t) (long) pos != pos) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+	return (long) pos;
 }
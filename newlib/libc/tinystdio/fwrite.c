@@ -35,16 +35,11 @@
 size_t
 fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
 {
-	size_t i, j;
-	const uint8_t *cp;
-
-	if ((stream->flags & __SWR) == 0)
+	if ((stream->flags & __SWR) == 0 || size == 0)
 		return 0;
 
-	for (i = 0, cp = (const uint8_t *)ptr; i < nmemb; i++)
-		for (j = 0; j < size; j++)
-			if (stream->put(*cp++, stream) != 0)
-				return i;
+	if (nmemb > SIZE_MAX / size)
+		nmemb = SIZE_MAX / size;
 
-	return i;
+	return __file_write(stream, ptr, size * nmemb) / size;
 }
@@ -34,34 +34,76 @@
  */
 
 #include "stdio_private.h"
+#include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 /* Posix I/O routines for tiny stdio */
 
+/*
+ * Buffers are allocated on first use so that a setvbuf call made
+ * before any I/O picks the size without wasting an initial
+ * allocation. Both directions share a single allocation.
+ */
+static bool
+__posix_alloc_buf(struct __file_posix *pf)
+{
+	uint8_t flags = pf->cfile.file.flags;
+	size_t ndir = ((flags & __SRD) ? 1 : 0) + ((flags & __SWR) ? 1 : 0);
+	char *buf;
+
+	buf = malloc((size_t) pf->buf_size * ndir);
+	if (!buf)
+		return false;
+	pf->buf_alloc = true;
+	if (flags & __SWR) {
+		pf->write_buf = buf;
+		buf += pf->buf_size;
+	}
+	if (flags & __SRD)
+		pf->read_buf = buf;
+	return true;
+}
+
+static void
+__posix_free_buf(struct __file_posix *pf)
+{
+	if (pf->buf_alloc)
+		free((pf->cfile.file.flags & __SWR) ? pf->write_buf : pf->read_buf);
+	pf->buf_alloc = false;
+	pf->write_buf = NULL;
+	pf->read_buf = NULL;
+}
+
+static int
+__posix_flush_locked(struct __file_posix *pf)
+{
+	int off = 0;
+
+	/* Flush everything, drop contents if that doesn't work */
+	while (pf->write_len) {
+		int this = write(pf->fd, pf->write_buf + off, pf->write_len);
+		if (this <= 0) {
+			pf->write_len = 0;
+			return -1;
+		}
+		off += this;
+		pf->write_len -= this;
+	}
+	return 0;
+}
+
 int
 __posix_flush(FILE *f)
 {
 	struct __file_posix *pf = (struct __file_posix *) f;
+	int ret;
 
 	__posix_lock(f);
-	if (pf->write_len) {
-		int off = 0;
-
-		/* Flush everything, drop contents if that doesn't work */
-		while (pf->write_len) {
-			int this = write(pf->fd, pf->write_buf + off, pf->write_len);
-			if (this <= 0) {
-				pf->write_len = 0;
-				__posix_unlock(f);
-				return -1;
-			}
-			off += this;
-			pf->write_len -= this;
-		}
-	}
+	ret = __posix_flush_locked(pf);
 	__posix_unlock(f);
-	return 0;
+	return ret;
 }
 
 int
@@ -71,10 +113,16 @@ __posix_putc(char c, FILE *f)
 	bool need_flush;
 
 	__posix_lock(f);
+	if (!pf->write_buf && !__posix_alloc_buf(pf)) {
+		__posix_unlock(f);
+		return EOF;
+	}
 	pf->write_buf[pf->write_len++] = c;
 
-	/* flush if full, or if sending newline to stdout/stderr */
-	need_flush = (pf->write_len >= BUFSIZ || (c == '\n' && pf->fd <= 2));
+	/* flush if full, unbuffered or sending newline in line mode */
+	need_flush = (pf->write_len >= pf->buf_size ||
+		      pf->buf_mode == _IONBF ||
+		      (c == '\n' && pf->buf_mode == _IOLBF));
 	__posix_unlock(f);
 
 	if (need_flush)
@@ -83,6 +131,65 @@ __posix_putc(char c, FILE *f)
 	return 0;
 }
 
+/*
+ * Copy a block into the write buffer, holding the lock across the
+ * whole transfer rather than once per byte.
+ */
+__ssize_t
+__posix_write(FILE *f, const void *buf, size_t len)
+{
+	struct __file_posix *pf = (struct __file_posix *) f;
+	const char *cp = buf;
+	size_t done = 0;
+
+	__posix_lock(f);
+
+	/*
+	 * Transfers at least as large as the buffer, and everything on
+	 * unbuffered streams, skip the buffer: flush anything pending
+	 * and hand the caller's memory straight to write(2)
+	 */
+	if (len >= (size_t) pf->buf_size || pf->buf_mode == _IONBF) {
+		if (__posix_flush_locked(pf) < 0)
+			goto fail;
+		while (done < len) {
+			ssize_t this = write(pf->fd, cp + done, len - done);
+			if (this <= 0)
+				goto fail;
+			done += this;
+		}
+		__posix_unlock(f);
+		return done;
+	}
+
+	if (!pf->write_buf && !__posix_alloc_buf(pf))
+		goto fail;
+
+	while (done < len) {
+		size_t this = pf->buf_size - pf->write_len;
+
+		if (this > len - done)
+			this = len - done;
+		memcpy(pf->write_buf + pf->write_len, cp + done, this);
+		pf->write_len += this;
+		done += this;
+		if (pf->write_len >= pf->buf_size && __posix_flush_locked(pf) < 0)
+			goto fail;
+	}
+
+	/* flush if sending newline in line mode */
+	if (pf->buf_mode == _IOLBF && memchr(buf, '\n', len) &&
+	    __posix_flush_locked(pf) < 0)
+		goto fail;
+
+	__posix_unlock(f);
+	return done;
+
+fail:
+	__posix_unlock(f);
+	return -1;
+}
+
 int
 __posix_getc(FILE *f)
 {
@@ -99,9 +206,14 @@ __posix_getc(FILE *f)
 			return __posix_getc(f);
 		}
 
+		if (!pf->read_buf && !__posix_alloc_buf(pf)) {
+			__posix_unlock(f);
+			return EOF;
+		}
+
 		/* Reset read pointer, read some data */
 		pf->read_off = 0;
-		pf->read_len = read(pf->fd, pf->read_buf, BUFSIZ);
+		pf->read_len = read(pf->fd, pf->read_buf, pf->buf_size);
 
 		if (pf->read_len <= 0) {
 			pf->read_len = 0;
@@ -119,6 +231,155 @@ __posix_getc(FILE *f)
 	return c;
 }
 
+/*
+ * Return whatever is sitting in the read buffer, refilling it first
+ * if empty. When the buffer is empty and the request is at least as
+ * large as the buffer, read(2) directly into the caller's memory.
+ * Like read(2), this may return fewer bytes than requested.
+ */
+__ssize_t
+__posix_read(FILE *f, void *buf, size_t len)
+{
+	struct __file_posix *pf = (struct __file_posix *) f;
+	size_t avail;
+
+	__posix_lock(f);
+	if (pf->read_off >= pf->read_len) {
+
+		/* Flush stdout if reading from stdin */
+		if (f == stdin) {
+			__posix_unlock(f);
+			fflush(stdout);
+			__posix_lock(f);
+		}
+
+		pf->read_off = 0;
+		pf->read_len = 0;
+
+		if (len >= (size_t) pf->buf_size) {
+			ssize_t ret = read(pf->fd, buf, len);
+			__posix_unlock(f);
+			return ret;
+		}
+
+		if (!pf->read_buf && !__posix_alloc_buf(pf)) {
+			__posix_unlock(f);
+			return -1;
+		}
+
+		/* Reset read pointer, read some data */
+		pf->read_len = read(pf->fd, pf->read_buf, pf->buf_size);
+
+		if (pf->read_len <= 0) {
+			int ret = pf->read_len;
+			pf->read_len = 0;
+			__posix_unlock(f);
+			return ret;
+		}
+	}
+
+	avail = pf->read_len - pf->read_off;
+	if (len > avail)
+		len = avail;
+	memcpy(buf, pf->read_buf + pf->read_off, len);
+	pf->read_off += len;
+	__posix_unlock(f);
+	return len;
+}
+
+/*
+ * Reposition the file. Seeks which land within the data held in the
+ * read buffer just move the read pointer; anything else discards the
+ * buffer and asks the OS.
+ */
+off_t
+__posix_seek(FILE *f, off_t offset, int whence)
+{
+	struct __file_posix *pf = (struct __file_posix *) f;
+	off_t ret;
+
+	__posix_lock(f);
+	if (__posix_flush_locked(pf) < 0) {
+		__posix_unlock(f);
+		return -1;
+	}
+
+	if (pf->read_len) {
+		off_t end = lseek(pf->fd, 0, SEEK_CUR);
+		off_t unread = pf->read_len - pf->read_off;
+
+		if (end >= 0 && whence != SEEK_END) {
+			off_t start = end - pf->read_len;
+			off_t target = offset;
+
+			if (whence == SEEK_CUR)
+				target += end - unread;
+			if (start <= target && target <= end) {
+				pf->read_off = target - start;
+				__posix_unlock(f);
+				return target;
+			}
+		}
+
+		/* The OS position is past the unread data */
+		if (whence == SEEK_CUR)
+			offset -= unread;
+		pf->read_len = 0;
+		pf->read_off = 0;
+	}
+
+	ret = lseek(pf->fd, offset, whence);
+	__posix_unlock(f);
+	return ret;
+}
+
+/*
+ * Select the buffering mode and, when size is non-zero, the buffer.
+ * A caller-supplied buffer is split between the two directions of a
+ * read/write stream; a heap buffer of 'size' bytes is allocated for
+ * each direction on first use.
+ */
+int
+__posix_setvbuf(FILE *f, char *buf, int mode, size_t size)
+{
+	struct __file_posix *pf = (struct __file_posix *) f;
+	size_t ndir = ((f->flags & __SRD) ? 1 : 0) + ((f->flags & __SWR) ? 1 : 0);
+
+	if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF)
+		return EOF;
+
+	__posix_lock(f);
+	if (__posix_flush_locked(pf) < 0) {
+		__posix_unlock(f);
+		return EOF;
+	}
+	pf->buf_mode = mode;
+	if (size) {
+		if (buf)
+			size /= ndir;
+		if (size > INT_MAX)
+			size = INT_MAX;
+		if (size == 0) {
+			__posix_unlock(f);
+			return EOF;
+		}
+		__posix_free_buf(pf);
+		pf->read_len = 0;
+		pf->read_off = 0;
+		pf->buf_size = size;
+		if (buf) {
+			if (f->flags & __SWR) {
+				pf->write_buf = buf;
+				buf += size;
+			}
+			if (f->flags & __SRD)
+				pf->read_buf = buf;
+		}
+	}
+	__posix_unlock(f);
+	return 0;
+}
+
 int
 __posix_close(FILE *f)
 {
@@ -133,16 +394,18 @@ __posix_close(FILE *f)
 	/* Don't close stdin/stdout/stderr fds */
 	if (pf->fd > 2)
 		close(pf->fd);
+	__posix_free_buf(pf);
 	free(f);
 	return ret;
 }
 
 /*
- * Add a destructor function to get stdout flushed on
+ * Add a destructor function to get stdout and stderr flushed on
  * exit
  */
 __attribute__((destructor (101)))
 static void posix_exit(void)
 {
 	__posix_flush(stdout);
+	__posix_flush(stderr);
 }
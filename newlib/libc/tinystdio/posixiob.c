@@ -42,21 +42,56 @@ static char read_buf[BUFSIZ];
 
 static struct __file_posix __stdin = {
 	.cfile = {
-		.file = FDEV_SETUP_STREAM(NULL, __posix_getc, NULL, __SRD | __SCLOSE),
-		.close = __posix_close
+		.file = {
+			.get = __posix_getc,
+			.read = __posix_read,
+			.flags = __SRD | __SCLOSE,
+		},
+		.close = __posix_close,
+		.seek = __posix_seek
 	},
 	.fd = 0,
-	.read_buf = read_buf
+	.read_buf = read_buf,
+	.buf_size = BUFSIZ,
+	.buf_mode = _IOLBF,
 };
 
 static struct __file_posix __stdout = {
 	.cfile = {
-		.file = FDEV_SETUP_STREAM(__posix_putc, NULL, __posix_flush, __SWR | __SCLOSE),
-		.close = __posix_close
+		.file = {
+			.put = __posix_putc,
+			.write = __posix_write,
+			.flush = __posix_flush,
+			.flags = __SWR | __SCLOSE,
+		},
+		.close = __posix_close,
+		.seek = __posix_seek
 	},
 	.fd = 1,
-	.write_buf = write_buf
+	.write_buf = write_buf,
+	.buf_size = BUFSIZ,
+	.buf_mode = _IOLBF,
 };
 
-FILE *const __posix_iob[3] = { &__stdin.cfile.file, &__stdout.cfile.file, &__stdout.cfile.file };
+/* stderr is unbuffered; the single byte holds one putc until it is written */
+static char err_buf[1];
+
+static struct __file_posix __stderr = {
+	.cfile = {
+		.file = {
+			.put = __posix_putc,
+			.write = __posix_write,
+			.flush = __posix_flush,
+			.flags = __SWR | __SCLOSE,
+		},
+		.close = __posix_close,
+		.seek = __posix_seek
+	},
+	.fd = 2,
+	.write_buf = err_buf,
+	.buf_size = sizeof(err_buf),
+	.buf_mode = _IONBF,
+};
+
+FILE *const __posix_iob[3] = { &__stdin.cfile.file, &__stdout.cfile.file, &__stderr.cfile.file };
 __weak_reference(__posix_iob,__iob);
@@ -31,19 +31,20 @@
 
 #include <stdio.h>
 #include "stdio_private.h"
+#include <string.h>
 
 int
 puts(const char *str)
 {
-	char c;
+	size_t len;
 	int rv = 0;
 
 	if ((stdout->flags & __SWR) == 0)
 		return EOF;
 
-	while ((c = *str++) != '\0')
-		if (stdout->put(c, stdout) != 0)
-			rv = EOF;
+	len = strlen(str);
+	if (__file_write(stdout, str, len) != len)
+		rv = EOF;
 	if (stdout->put('\n', stdout) != 0)
 		rv = EOF;
 
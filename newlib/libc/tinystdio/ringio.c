@@ -0,0 +1,315 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+#include <string.h>
+
+#ifndef ATOMIC_UNGETC
+#error "ring buffered output needs the atomic-ungetc option"
+#endif
+
+/*
+ * Ring-buffered output. Producers never block each other while
+ * formatting: each thread collects a line in thread-local storage,
+ * reserves room for the line and a length header with a single
+ * compare-and-swap on 'head', copies the line in and then commits it
+ * by storing its length in the header. The drainer walks the records
+ * from 'tail' and stops at the first header which is still zero, so
+ * nothing is sent until every earlier reservation has been filled,
+ * whatever order the producers finish in. Drained records are zeroed
+ * again for the next lap around the ring.
+ *
+ * A producer which finds the ring full drains it itself, or waits
+ * while another context is draining, however slow the device is. When
+ * nobody is draining, the space may be held by a producer which cannot
+ * run until this one returns, so once RING_RESERVE_TRIES attempts in a
+ * row free nothing, the record is dropped and the write fails.
+ *
+ * The indices run freely and wrap modulo the range of __ungetc_t,
+ * which is why the ring can be at most half that size.
+ */
+
+#ifndef RING_LINE_SIZE
+#define RING_LINE_SIZE	128
+#endif
+
+#ifndef RING_RESERVE_TRIES
+#define RING_RESERVE_TRIES	1000
+#endif
+
+/* Called each pass while waiting for another context to drain */
+#ifndef RING_WAIT
+#define RING_WAIT()
+#endif
+
+#define RING_HDR	((__ungetc_t) sizeof(__ungetc_t))
+
+static NEWLIB_THREAD_LOCAL struct {
+	FILE		*file;
+	uint16_t	len;
+	char		buf[RING_LINE_SIZE];
+} ring_line;
+
+static inline __ungetc_t
+ring_load(__ungetc_t *p)
+{
+	return *(volatile __ungetc_t *) p;
+}
+
+/* Load with acquire ordering: a compare-and-swap which stores the same value */
+static __ungetc_t
+ring_acquire(__ungetc_t *p)
+{
+	__ungetc_t v;
+
+	do
+		v = ring_load(p);
+	while (!__atomic_compare_exchange_ungetc(p, v, v));
+	return v;
+}
+
+/* Store with release ordering, for values only this context writes */
+static void
+ring_release(__ungetc_t *p, __ungetc_t v)
+{
+	__ungetc_t o;
+
+	do
+		o = ring_load(p);
+	while (!__atomic_compare_exchange_ungetc(p, o, v));
+}
+
+/* Records start on header boundaries, so headers never wrap */
+static inline __ungetc_t *
+ring_hdr(struct __file_ring *rf, __ungetc_t pos)
+{
+	return (__ungetc_t *) (rf->buf + (pos & (rf->size - 1)));
+}
+
+/* Ring space used by a record holding len bytes */
+static inline __ungetc_t
+ring_span(__ungetc_t len)
+{
+	return (__ungetc_t) (RING_HDR + len + RING_HDR - 1) & (__ungetc_t) ~(RING_HDR - 1);
+}
+
+static int
+ring_drain(struct __file_ring *rf)
+{
+	__ungetc_t mask = rf->size - 1;
+	int ret = 0;
+
+	if (!__atomic_compare_exchange_ungetc(&rf->draining, 0, 1))
+		return 0;
+
+	for (;;) {
+		__ungetc_t tail = rf->tail;
+		__ungetc_t len, span, off, first;
+
+		if (tail == ring_load(&rf->head))
+			break;
+
+		/* Stop at the first reservation which is still being filled */
+		len = ring_acquire(ring_hdr(rf, tail));
+		if (len == 0)
+			break;
+
+		off = (tail + RING_HDR) & mask;
+		first = rf->size - off;
+		if (first > len)
+			first = len;
+
+		/* Data is consumed even if the device fails */
+		if ((*rf->drain)(rf->buf + off, first) < 0)
+			ret = EOF;
+		if (len > first && (*rf->drain)(rf->buf, len - first) < 0)
+			ret = EOF;
+
+		/* Clear the whole record so no stale byte looks like a header */
+		span = ring_span(len);
+		off = tail & mask;
+		first = rf->size - off;
+		if (first > span)
+			first = span;
+		memset(rf->buf + off, 0, first);
+		memset(rf->buf, 0, span - first);
+
+		/* Only the drainer writes tail */
+		ring_release(&rf->tail, tail + span);
+	}
+
+	ring_release(&rf->draining, 0);
+	return ret;
+}
+
+int
+fdev_ring_drain(FILE *stream)
+{
+	return ring_drain((struct __file_ring *) stream);
+}
+
+/*
+ * Reserve room for a record of len bytes, draining when the ring is
+ * full. Returns EOF if the ring stopped emptying with nobody draining.
+ */
+static int
+ring_reserve(struct __file_ring *rf, __ungetc_t len, __ungetc_t *pos)
+{
+	__ungetc_t span = ring_span(len);
+	__ungetc_t head, tail, last_tail;
+	int tries = 0;
+
+	last_tail = ring_load(&rf->tail);
+	for (;;) {
+		head = ring_load(&rf->head);
+		tail = ring_acquire(&rf->tail);
+		if ((__ungetc_t) (rf->size - (__ungetc_t) (head - tail)) < span) {
+			if (ring_load(&rf->draining)) {
+				RING_WAIT();
+				tries = 0;
+				continue;
+			}
+			if (tail != last_tail) {
+				last_tail = tail;
+				tries = 0;
+			}
+			if (++tries > RING_RESERVE_TRIES)
+				return EOF;
+			(void) ring_drain(rf);
+			continue;
+		}
+		if (__atomic_compare_exchange_ungetc(&rf->head, head, head + span))
+			break;
+	}
+	*pos = head;
+	return 0;
+}
+
+/* Copy a record into its reservation and commit it */
+static void
+ring_fill(struct __file_ring *rf, __ungetc_t pos, const char *data, __ungetc_t len)
+{
+	__ungetc_t off = (pos + RING_HDR) & (rf->size - 1);
+	__ungetc_t first = rf->size - off;
+
+	if (first > len)
+		first = len;
+	memcpy(rf->buf + off, data, first);
+	memcpy(rf->buf, data + first, len - first);
+	ring_release(ring_hdr(rf, pos), len);
+}
+
+/* Copy one record into the ring, returning EOF if it was dropped */
+static int
+ring_commit(struct __file_ring *rf, const char *data, size_t len)
+{
+	__ungetc_t max = rf->size - RING_HDR;
+
+	while (len) {
+		__ungetc_t pos, this;
+
+		/* Records larger than the ring are split */
+		this = len > max ? max : (__ungetc_t) len;
+		if (ring_reserve(rf, this, &pos) < 0)
+			return EOF;
+		ring_fill(rf, pos, data, this);
+		data += this;
+		len -= this;
+	}
+	return 0;
+}
+
+/* Move this thread's pending line into the ring */
+static int
+ring_commit_line(void)
+{
+	int ret = 0;
+
+	if (ring_line.len) {
+		ret = ring_commit((struct __file_ring *) ring_line.file, ring_line.buf, ring_line.len);
+		ring_line.len = 0;
+	}
+	return ret;
+}
+
+/* Make sure the thread-local line belongs to this stream */
+static void
+ring_claim_line(FILE *stream)
+{
+	if (ring_line.file != stream) {
+		(void) ring_commit_line();
+		ring_line.file = stream;
+	}
+}
+
+int
+__ring_put(char c, FILE *stream)
+{
+	ring_claim_line(stream);
+	ring_line.buf[ring_line.len++] = c;
+	if (c == '\n' || ring_line.len >= RING_LINE_SIZE)
+		return ring_commit_line();
+	return 0;
+}
+
+__ssize_t
+__ring_write(FILE *stream, const void *buf, size_t len)
+{
+	ring_claim_line(stream);
+	if (ring_line.len + len <= RING_LINE_SIZE) {
+		memcpy(ring_line.buf + ring_line.len, buf, len);
+		ring_line.len += len;
+		if (ring_line.len >= RING_LINE_SIZE || memchr(buf, '\n', len))
+			if (ring_commit_line() < 0)
+				return -1;
+	} else {
+		if (ring_commit_line() < 0 ||
+		    ring_commit((struct __file_ring *) stream, buf, len) < 0)
+			return -1;
+	}
+	return len;
+}
+
+int
+__ring_flush(FILE *stream)
+{
+	int ret = 0;
+
+	if (ring_line.file == stream)
+		ret = ring_commit_line();
+	if (ring_drain((struct __file_ring *) stream) < 0)
+		ret = EOF;
+	return ret;
+}
@@ -33,11 +33,17 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdio.h>
+#include "stdio_private.h"
 
 int
 setvbuf(FILE *stream, char *buf, int mode, size_t size)
 {
+#ifdef POSIX_IO
+	/* Only POSIX streams have buffers to adjust */
+	if ((stream->flags & __SCLOSE) &&
+	    ((struct __file_close *) stream)->close == __posix_close)
+		return __posix_setvbuf(stream, buf, mode, size);
+#endif
 	(void) stream;
 	(void) buf;
 	(void) mode;
@@ -174,6 +174,37 @@
     harmless, it will cause an undefined reference to free() and thus
     cause the linker to link the malloc module into the application.
 
+    <h4>Block transfers</h4>
+
+    Devices which can move more than one byte at a time may also set
+    the \c write and \c read members of the FILE.  When present,
+    fwrite(), fputs(), puts() and the literal and string portions of
+    printf() output hand whole blocks to \c write, and fread() pulls
+    whole blocks from \c read, instead of calling \c put or \c get once
+    per byte.  \c write returns the number of bytes accepted (a short
+    count indicates an error); \c read returns the number of bytes
+    stored, 0 at end of file, or a negative value on error, just like
+    the POSIX functions of the same names.  Leaving them NULL, as
+    FDEV_SETUP_STREAM() does, selects the per-character paths.
+
+    <h4>Ring buffered output</h4>
+
+    FDEV_SETUP_RING(buf, size, drain) initializes a write-only stream
+    which many threads can use without taking a lock for each
+    character.  Each thread collects its output a line at a time, then
+    copies the whole line into \c buf with one atomic reservation, so
+    lines from different threads never interleave.  Nothing reaches
+    the device until fdev_ring_drain() or fflush() is called, or the
+    ring fills up; a low priority task would typically call
+    fdev_ring_drain() periodically.  A writer finding the ring full
+    waits for a drain already in progress.  If the ring stays full
+    with nobody draining, for instance because the thread holding the
+    oldest reservation cannot run, the write is dropped and reports an
+    error rather than waiting forever.  \c buf must be zero-filled and aligned for __ungetc_t;
+    a static array of __ungetc_t satisfies both.  The atomic
+    operations are those used for ungetc(), so ring streams are only
+    available when the atomic-ungetc option is enabled.
+
     <h3>Notes</h3>
 
     \anchor stdio_note1 \par Note 1:
@@ -258,6 +289,8 @@ struct __file {
 	int	(*put)(char, struct __file *);	/* function to write one char to device */
 	int	(*get)(struct __file *);	/* function to read one char from device */
 	int	(*flush)(struct __file *);	/* function to flush output to device */
+	__ssize_t (*write)(struct __file *, const void *, size_t);	/* optional: write block to device */
+	__ssize_t (*read)(struct __file *, void *, size_t);	/* optional: read block from device */
 };
 
 /*
@@ -267,6 +300,25 @@ struct __file {
 struct __file_close {
 	struct __file file;			/* main file struct */
 	int	(*close)(struct __file *);	/* function to close file */
+	__off_t	(*seek)(struct __file *, __off_t, int);	/* optional: reposition file */
+};
+
+/*
+ * This variant collects output from all threads into a shared ring
+ * buffer. Each thread gathers a line at a time and copies it into
+ * the ring with a single atomic reservation; completed data is
+ * handed to 'drain' by fdev_ring_drain(). 'size' must be a power of
+ * two no larger than half the range of __ungetc_t, and 'buf' must be
+ * zero-filled and aligned for __ungetc_t.
+ */
+struct __file_ring {
+	struct __file file;			/* main file struct */
+	char	*buf;				/* ring storage */
+	__ungetc_t size;			/* size of buf */
+	__ungetc_t head;			/* next byte to reserve */
+	__ungetc_t tail;			/* next byte to drain */
+	__ungetc_t draining;			/* set while a thread drains */
+	int	(*drain)(const char *, size_t);	/* function to write data to device */
 };
 
 #endif /* not __DOXYGEN__ */
@@ -392,8 +444,34 @@ extern struct __file *const __iob[];
 
 extern FILE *fdevopen(int (*__put)(char, FILE*), int (*__get)(FILE*), int(*__flush)(FILE *));
 
+int	__ring_put(char c, FILE *stream);
+__ssize_t __ring_write(FILE *stream, const void *buf, size_t len);
+int	__ring_flush(FILE *stream);
+
+#define FDEV_SETUP_RING(_buf, _size, _drain) {		\
+		.file = {				\
+			.put = __ring_put,		\
+			.write = __ring_write,		\
+			.flush = __ring_flush,		\
+			.flags = __SWR,			\
+		},					\
+		.buf = (char *) (_buf),			\
+		.size = (_size),			\
+		.drain = (_drain),			\
+	}
+
 #endif /* not __DOXYGEN__ */
 
+/**
+   Write out data collected by a stream set up with FDEV_SETUP_RING().
+
+   Any complete lines in the ring are passed to the stream's \c drain
+   function.  Only one thread drains at a time; if another thread is
+   already draining, this returns immediately.  Returns 0 on success,
+   or \c EOF if \c drain reported an error.
+*/
+extern int	fdev_ring_drain(FILE *__stream);
+
 /**
    This function closes \c stream, and disallows and further
    IO to and from it.
@@ -691,6 +769,84 @@ vasprintf(char **strp, const char *fmt, va_list ap) __PRINTF_ATTRIBUTE__(2,0);
 */
 extern int	fprintf(FILE *__stream, const char *__fmt, ...) __PRINTF_ATTRIBUTE__(2, 3);
 
+/**
+   One step of a pre-parsed printf format: a run of literal text
+   followed by a conversion. \c conv is \c '%' when the entry is only
+   literal text, and \c '\0' in the last entry of a plan.
+*/
+struct printf_op {
+	const char	*lit;
+	size_t		lit_len;
+	int		width;
+	int		prec;
+	unsigned short	flags;
+	unsigned char	conv;
+	unsigned char	star;
+};
+
+/**
+   Parse \c fmt into at most \c nops entries of \c plan, which can
+   then be passed to \c vfprintf_plan() any number of times without
+   parsing the format again. The plan refers to the literal text in
+   \c fmt, which must remain valid while the plan is used.
+
+   Returns the number of entries the whole format needs, which is
+   larger than \c nops if \c plan is too small, or -1 if \c fmt is
+   malformed.
+
+   Plans always use the default printf, so \c printf_float() cannot
+   be used with them.
+*/
+extern int	printf_plan_compile(struct printf_op *__plan, size_t __nops, const char *__fmt);
+
+/**
+   Format the arguments in \c ap according to \c plan, as
+   \c vfprintf() would with the format the plan was compiled from.
+*/
+extern int	vfprintf_plan(FILE *__stream, const struct printf_op *__plan, va_list __ap);
+
+/**
+   Variant of \c vfprintf_plan() taking a variable argument list.
+*/
+extern int	fprintf_plan(FILE *__stream, const struct printf_op *__plan, ...);
+
+/**
+   Largest plan kept by \c fprintf_planned().
+*/
+#ifndef PRINTF_PLAN_MAX
+#define PRINTF_PLAN_MAX	16
+#endif
+
+/**
+   Like \c fprintf(), but a constant \c fmt is compiled into a plan
+   the first time each call site runs and the plan is reused after
+   that. Other formats are passed to \c fprintf(). Only one caller
+   compiles the plan; concurrent callers use \c fprintf() until it
+   is ready.
+*/
+#if defined(__GNUC__) && !defined(__DOXYGEN__)
+#define fprintf_planned(__stream, __fmt, ...) __extension__ ({		\
+	static struct printf_op __plan[PRINTF_PLAN_MAX];		\
+	static int __plan_ops;						\
+	int __ops = 0;							\
+	if (__builtin_constant_p(__fmt)) {				\
+		__ops = __atomic_load_n(&__plan_ops, __ATOMIC_ACQUIRE);	\
+		if (__ops == 0 &&					\
+		    __atomic_compare_exchange_n(&__plan_ops, &__ops, -2, 0, \
+						__ATOMIC_ACQUIRE,	\
+						__ATOMIC_ACQUIRE)) {	\
+			__ops = printf_plan_compile(__plan, PRINTF_PLAN_MAX, __fmt); \
+			__atomic_store_n(&__plan_ops, __ops, __ATOMIC_RELEASE); \
+		}							\
+	}								\
+	(0 < __ops && __ops <= PRINTF_PLAN_MAX) ?			\
+		fprintf_plan(__stream, __plan, ##__VA_ARGS__) :		\
+		fprintf(__stream, __fmt, ##__VA_ARGS__);		\
+	})
+#else
+#define fprintf_planned fprintf
+#endif
+
 /**
    Write the string pointed to by \c str to stream \c stream.
 
@@ -865,19 +1021,31 @@ extern int	sscanf(const char *__buf, const char *__fmt, ...) __FORMAT_ATTRIBUTE_
 extern int	fflush(FILE *stream);
 
 #ifndef __DOXYGEN__
-/* only mentioned for libstdc++ support, not implemented in library */
+/*
+ * Positioning works on streams whose __file_close has a 'seek'
+ * function; others report ESPIPE. The rest are only mentioned for
+ * libstdc++ support.
+ */
 #ifndef BUFSIZ
 #define BUFSIZ 512
 #endif
-#define _IONBF 0
+#define _IONBF 0	/* unbuffered */
+#define _IOLBF 1	/* line buffered */
+#define _IOFBF 2	/* fully buffered */
+#ifndef _OFF_T_DECLARED
+typedef __off_t off_t;
+#define _OFF_T_DECLARED
+#endif
 __extension__ typedef long long fpos_t;
 extern int fgetpos(FILE *stream, fpos_t *pos);
 extern FILE *fopen(const char *path, const char *mode);
 extern FILE *freopen(const char *path, const char *mode, FILE *stream);
 extern FILE *fdopen(int, const char *);
 extern int fseek(FILE *stream, long offset, int whence);
+extern int fseeko(FILE *stream, off_t offset, int whence);
 extern int fsetpos(FILE *stream, fpos_t *pos);
 extern long ftell(FILE *stream);
+extern off_t ftello(FILE *stream);
 extern int fileno(FILE *);
 extern void perror(const char *s);
 extern int remove(const char *pathname);
@@ -64,6 +64,33 @@ __file_str_put(char c, FILE *stream);
 int
 __file_str_put_alloc(char c, FILE *stream);
 
+__ssize_t
+__file_str_write(FILE *stream, const void *buf, size_t len);
+
+__ssize_t
+__file_str_write_alloc(FILE *stream, const void *buf, size_t len);
+
+/*
+ * Send a block of bytes to the device, using the block write function
+ * when the device has one and falling back to one 'put' call per byte
+ * otherwise. Returns the number of bytes accepted by the device.
+ */
+static inline size_t
+__file_write(FILE *stream, const void *buf, size_t len)
+{
+	const char *cp = buf;
+	size_t i;
+
+	if (stream->write) {
+		__ssize_t ret = (*stream->write)(stream, buf, len);
+		return ret < 0 ? 0 : (size_t) ret;
+	}
+	for (i = 0; i < len; i++)
+		if ((*stream->put)(cp[i], stream) != 0)
+			break;
+	return i;
+}
+
 /*
  * It is OK to discard the "const" qualifier here.  f.buf is
  * non-const as in the generic case, this buffer is obtained
@@ -83,7 +110,8 @@ __file_str_put_alloc(char c, FILE *stream);
 #define FDEV_SETUP_STRING_WRITE(_s, _size) {	\
 		.file = {			\
 			.flags = __SWR,		\
-			.put = __file_str_put	\
+			.put = __file_str_put,	\
+			.write = __file_str_write \
 		},				\
 		.buf = (_s),			\
 		.size = (_size),		\
@@ -93,7 +121,8 @@ __file_str_put_alloc(char c, FILE *stream);
 #define FDEV_SETUP_STRING_ALLOC() {		\
 		.file = {			\
 			.flags = __SWR,		\
-			.put = __file_str_put_alloc	\
+			.put = __file_str_put_alloc,	\
+			.write = __file_str_write_alloc \
 		},				\
 		.buf = NULL,			\
 		.size = 0,			\
@@ -110,6 +139,9 @@ struct __file_posix {
 	char	*read_buf;
 	int	read_len;
 	int	read_off;
+	int	buf_size;	/* size of each of read_buf and write_buf */
+	uint8_t	buf_mode;	/* _IOFBF, _IOLBF or _IONBF */
+	bool	buf_alloc;	/* buffers were allocated by the library */
 #ifndef __SINGLE_THREAD__
 	_LOCK_T lock;
 #endif
@@ -156,6 +188,7 @@ static inline void __posix_unlock(FILE *f) {
 }
 
 int	__d_vfprintf(FILE *__stream, const char *__fmt, va_list __ap) __FORMAT_ATTRIBUTE__(printf, 2, 0);
+int	__m_vfprintf(FILE *__stream, const char *__fmt, va_list __ap) __FORMAT_ATTRIBUTE__(printf, 2, 0);
 int	__f_vfprintf(FILE *__stream, const char *__fmt, va_list __ap) __FORMAT_ATTRIBUTE__(printf, 2, 0);
 
 int	__d_sprintf(char *__s, const char *__fmt, ...) __FORMAT_ATTRIBUTE__(printf, 2, 0);
@@ -173,6 +206,18 @@ __posix_putc(char c, FILE *f);
 int
 __posix_getc(FILE *f);
 
+__ssize_t
+__posix_write(FILE *f, const void *buf, size_t len);
+
+__ssize_t
+__posix_read(FILE *f, void *buf, size_t len);
+
+off_t
+__posix_seek(FILE *f, off_t offset, int whence);
+
+int
+__posix_setvbuf(FILE *f, char *buf, int mode, size_t size);
+
 int
 __posix_close(FILE *f);
 
@@ -184,6 +229,36 @@ __atod_engine(uint64_t m10, int e10);
 float
 __atof_engine(uint32_t m10, int e10);
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+#define _ATOD_EIGHT_DIGITS
+
+/*
+ * When s starts with eight decimal digits, convert them all at once
+ * using a few 64-bit operations in place of eight dependent
+ * multiply-adds. The characters are checked in order first, so this
+ * never reads past the end of the string.
+ */
+static inline bool
+__atod_eight_digits(const char *s, uint32_t *v)
+{
+	uint64_t	w = 0;
+	int		i;
+
+	for (i = 0; i < 8; i++)
+		if ((unsigned char) (s[i] - '0') > 9)
+			return false;
+	/* first digit in the low byte; compilers merge this into one load */
+	for (i = 8; i-- > 0;)
+		w = (w << 8) | (unsigned char) s[i];
+	w -= 0x3030303030303030ULL;
+	w = (w * 10) + (w >> 8);
+	w = (((w & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32))) +
+	     (((w >> 16) & 0x000000ff000000ffULL) * (1 + (10000ULL << 32)))) >> 32;
+	*v = (uint32_t) w;
+	return true;
+}
+#endif
+
 static inline uint16_t
 __non_atomic_exchange_ungetc(__ungetc_t *p, __ungetc_t v)
 {
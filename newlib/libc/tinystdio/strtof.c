@@ -123,6 +123,32 @@ strtof (const char * nptr, char ** endptr)
     exp = 0;
     while (1) {
 
+#ifdef _ATOD_EIGHT_DIGITS
+	uint32_t eight;
+	if (!(flag & FL_OVFL) && u32digits <= 1 &&
+	    __atod_eight_digits(nptr - 1, &eight))
+	{
+	    flag |= FL_ANY;
+	    if (flag & FL_DOT)
+		exp -= 8;
+	    if (u32) {
+		u32digits += 8;
+	    } else {
+		/* leading zeros are not significant */
+		int z = 0;
+		while (z < 8 && nptr[z - 1] == '0')
+		    z++;
+		u32digits = 8 - z;
+	    }
+	    u32 = u32 * 100000000 + eight;
+	    if (u32digits > 8)
+		flag |= FL_OVFL;
+	    c = nptr[7];
+	    nptr += 8;
+	    continue;
+	}
+#endif
+
 	c -= '0';
 
 	if (c <= 9) {
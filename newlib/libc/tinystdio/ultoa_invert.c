@@ -37,9 +37,14 @@ typedef struct {
  * Use the krufty divmod10 code when doing 64-bit
  * ultoa on targets where long is smaller than 64 bits,
  * which we're guessing happens when the target doesn't have
- * native 64-bit divides
+ * native 64-bit divides. Defining ULTOA_NO_DIV64 selects the
+ * same code elsewhere, which lets 64-bit hosts test it.
  */
-#if SIZEOF_ULTOA == 8 && __SIZEOF_LONG__ < 8
+#if __SIZEOF_LONG__ < 8 && !defined(ULTOA_NO_DIV64)
+#define ULTOA_NO_DIV64
+#endif
+
+#if SIZEOF_ULTOA == 8 && defined(ULTOA_NO_DIV64)
 
 typedef struct {
 	uint64_t	lo;
@@ -168,11 +173,123 @@ static inline divmod_t divmodbase(ultoa_unsigned_t val, int base)
 #endif
 
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+
+/*
+ * Decimal conversion two digits at a time. The table holds the
+ * digits of each value from 0 to 99, least significant first to
+ * match the inverted output
+ */
+static const char __ultoa_pairs[200] =
+	"00102030405060708090"
+	"01112131415161718191"
+	"02122232425262728292"
+	"03132333435363738393"
+	"04142434445464748494"
+	"05152535455565758595"
+	"06162636465666768696"
+	"07172737475767778797"
+	"08182838485868788898"
+	"09192939495969798999";
+
+static inline char *
+__ultoa_pair(unsigned v, char *str)
+{
+	str[0] = __ultoa_pairs[v * 2];
+	str[1] = __ultoa_pairs[v * 2 + 1];
+	return str + 2;
+}
+
+/* Convert a value which fits in 32 bits */
+static inline char *
+__ultoa_dec32(uint32_t val, char *str)
+{
+	while (val >= 100) {
+		uint32_t q = val / 100;
+		str = __ultoa_pair(val - q * 100, str);
+		val = q;
+	}
+	if (val >= 10)
+		return __ultoa_pair(val, str);
+	*str++ = '0' + val;
+	return str;
+}
+
+#if SIZEOF_ULTOA == 8 && defined(ULTOA_NO_DIV64)
+
+/* High 64 bits of a 64x64 bit multiply, using 32x32 bit multiplies */
+static inline uint64_t
+__ultoa_umulh(uint64_t a, uint64_t b)
+{
+	uint64_t a_lo = (uint32_t) a, a_hi = a >> 32;
+	uint64_t b_lo = (uint32_t) b, b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo;
+	uint64_t hi_lo = a_hi * b_lo;
+	uint64_t lo_hi = a_lo * b_hi;
+	uint64_t mid = (lo_lo >> 32) + (uint32_t) hi_lo + (uint32_t) lo_hi;
+
+	return a_hi * b_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+}
+
+/* Convert exactly eight digits, including leading zeros */
+static inline char *
+__ultoa_dec8(uint32_t val, char *str)
+{
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		uint32_t q = val / 100;
+		str = __ultoa_pair(val - q * 100, str);
+		val = q;
+	}
+	return str;
+}
+
+/*
+ * Without native 64-bit divides, peel off eight digits at a time by
+ * multiplying with the reciprocal of 10**8 until the value fits in
+ * 32 bits
+ */
+static inline char *
+__ultoa_decimal(uint64_t val, char *str)
+{
+	while (val >> 32) {
+		uint64_t q = __ultoa_umulh(val, 0xabcc77118461cefdULL) >> 26;
+		str = __ultoa_dec8((uint32_t) (val - q * 100000000), str);
+		val = q;
+	}
+	return __ultoa_dec32((uint32_t) val, str);
+}
+
+#else
+
+static inline char *
+__ultoa_decimal(ultoa_unsigned_t val, char *str)
+{
+#if SIZEOF_ULTOA > 4
+	while (val > 0xffffffffUL) {
+		ultoa_unsigned_t q = val / 100;
+		str = __ultoa_pair(val - q * 100, str);
+		val = q;
+	}
+#endif
+	return __ultoa_dec32((uint32_t) val, str);
+}
+
+#endif
+
+#define ULTOA_DECIMAL_PAIRS
+#endif
+
 static char *
 __ultoa_invert(ultoa_unsigned_t val, char *str, int base)
 {
 	int upper = 0;
 
+#ifdef ULTOA_DECIMAL_PAIRS
+	if (base == 10)
+		return __ultoa_decimal(val, str);
+#endif
 	if (base & XTOA_UPPER) {
 		upper = 1;
 		base &= ~XTOA_UPPER;
@@ -145,6 +145,9 @@ typedef long ultoa_signed_t;
 #define FL_ALTLWR	0x20
 #define FL_NEGATIVE	0x40
 #define FL_LONG 	0x80
+/* 'h' is skipped and 'll' rejected by the minimal parser */
+#define FL_SHORT	0
+#define FL_REPD_TYPE	0
 
 int
 vfprintf (FILE * stream, const char *fmt, va_list ap)
@@ -152,10 +155,12 @@ vfprintf (FILE * stream, const char *fmt, va_list ap)
     unsigned char c;		/* holds a char from the format string */
     unsigned char flags;
     unsigned char buf[PRINTF_BUF_SIZE];	/* size for -1 in octal, without '\0'	*/
+    const char * pnt;
 
     int stream_len = 0;
 
 #define my_putc(c, stream) do { ++stream_len; putc(c, stream); } while(0)
+#define my_puts(s, l, stream) do { stream_len += (l); __file_write(stream, s, l); } while(0)
 
     if ((stream->flags & __SWR) == 0)
 	return EOF;
@@ -163,12 +168,16 @@ vfprintf (FILE * stream, const char *fmt, va_list ap)
     for (;;) {
 
 	for (;;) {
-	    c = *fmt++;
+	    /* Send runs of literal text as a single block */
+	    pnt = fmt;
+	    while ((c = *fmt) != '\0' && c != '%')
+		fmt++;
+	    if (fmt != pnt)
+		my_puts (pnt, fmt - pnt, stream);
 	    if (!c) goto ret;
-	    if (c == '%') {
-		c = *fmt++;
-		if (c != '%') break;
-	    }
+	    fmt++;
+	    c = *fmt++;
+	    if (c != '%') break;
 	    my_putc (c, stream);
 	}
 
@@ -198,8 +207,6 @@ vfprintf (FILE * stream, const char *fmt, va_list ap)
 	}
 
 	{
-	    const char * pnt;
-
 	    switch (c) {
 
 	      case 'c':
@@ -312,12 +319,144 @@ vfprintf (FILE * stream, const char *fmt, va_list ap)
 #define FL_FLTEXP	0x4000
 #define	FL_FLTFIX	0x8000
 
-int vfprintf (FILE * stream, const char *fmt, va_list ap)
+/* Width or precision given as '*' */
+#define STAR_WIDTH	0x01
+#define STAR_PREC	0x02
+
+/*
+ * Parse one conversion specification, starting just past the '%',
+ * into 'op'. Returns a pointer past the conversion character, or NULL
+ * if the specification is malformed
+ */
+static const char *
+printf_parse (const char *fmt, struct printf_op *op)
+{
+    unsigned char c;
+    uint16_t flags = 0;
+    int width = 0;
+    int prec = 0;
+    unsigned char star = 0;
+
+    while ((c = *fmt++) != 0) {
+	if (flags < FL_WIDTH) {
+	    switch (c) {
+	      case '0':
+		flags |= FL_ZFILL;
+		continue;
+	      case '+':
+		flags |= FL_PLUS;
+		/* FALLTHROUGH */
+	      case ' ':
+		flags |= FL_SPACE;
+		continue;
+	      case '-':
+		flags |= FL_LPAD;
+		continue;
+	      case '#':
+		flags |= FL_ALT;
+		continue;
+	    }
+	}
+
+	if (flags < FL_LONG) {
+	    if (c >= '0' && c <= '9') {
+		c -= '0';
+		if (flags & FL_PREC) {
+		    prec = 10*prec + c;
+		    continue;
+		}
+		width = 10*width + c;
+		flags |= FL_WIDTH;
+		continue;
+	    }
+	    if (c == '*') {
+		if (flags & FL_PREC) {
+		    star |= STAR_PREC;
+		} else {
+		    star |= STAR_WIDTH;
+		    flags |= FL_WIDTH;
+		}
+		continue;
+	    }
+	    if (c == '.') {
+		if (flags & FL_PREC)
+		    return NULL;
+		flags |= FL_PREC;
+		continue;
+	    }
+	}
+
+	if (c == 'l') {
+	    if (flags & FL_LONG) {
+#ifdef _WANT_IO_C99_FORMATS
+	    is_long_long:
+#endif
+		flags |= FL_REPD_TYPE;
+	    }
+#ifdef _WANT_IO_C99_FORMATS
+	is_long:
+#endif
+	    flags |= FL_LONG;
+	    flags &= ~FL_SHORT;
+	    continue;
+	}
+
+	if (c == 'h') {
+	    if (flags & FL_SHORT)
+		flags |= FL_REPD_TYPE;
+#ifdef _WANT_IO_C99_FORMATS
+	is_short:
+#endif
+	    flags |= FL_SHORT;
+	    flags &= ~FL_LONG;
+	    continue;
+	}
+
+#ifdef _WANT_IO_C99_FORMATS
+#define CHECK_INT_SIZE(letter, type) do {			\
+	    if (c == letter) {					\
+		if (sizeof(type) == sizeof(int))		\
+		    continue;					\
+		if (sizeof(type) == sizeof(long))		\
+		    goto is_long;				\
+		if (sizeof(type) == sizeof(long long))		\
+		    goto is_long_long;				\
+		if (sizeof(type) == sizeof(short))		\
+		    goto is_short;				\
+	    }							\
+	} while(0)
+
+	CHECK_INT_SIZE('j', intmax_t);
+	CHECK_INT_SIZE('z', size_t);
+	CHECK_INT_SIZE('t', ptrdiff_t);
+#endif
+
+	break;
+    }
+
+    if (!c)
+	return NULL;
+
+    op->flags = flags;
+    op->width = width;
+    op->prec = prec;
+    op->conv = c;
+    op->star = star;
+    return fmt;
+}
+
+/*
+ * Format either 'fmt' or, when 'fmt' is NULL, the pre-parsed 'plan'
+ */
+static int
+printf_run (FILE * stream, const char *fmt, const struct printf_op *plan, va_list ap)
 {
     unsigned char c;		/* holds a char from the format string */
     uint16_t flags;
     int width;
     int prec;
+    struct printf_op fmt_op;
+    const struct printf_op *op;
     union {
 	unsigned char __buf[PRINTF_BUF_SIZE];	/* size for -1 in octal, without '\0'	*/
 #if PRINTF_LEVEL >= PRINTF_FLT
@@ -334,128 +473,56 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap)
     int stream_len = 0;
 
 #define my_putc(c, stream) do { ++stream_len; putc(c, stream); } while(0)
+#define my_puts(s, l, stream) do { stream_len += (l); __file_write(stream, s, l); } while(0)
 
     if ((stream->flags & __SWR) == 0)
 	return EOF;
 
     for (;;) {
 
-	for (;;) {
-	    c = *fmt++;
-	    if (!c) goto ret;
-	    if (c == '%') {
-		c = *fmt++;
-		if (c != '%') break;
-	    }
-	    my_putc (c, stream);
-	}
-
-	flags = 0;
-	width = 0;
-	prec = 0;
-	
-	do {
-	    if (flags < FL_WIDTH) {
-		switch (c) {
-		  case '0':
-		    flags |= FL_ZFILL;
-		    continue;
-		  case '+':
-		    flags |= FL_PLUS;
-		    /* FALLTHROUGH */
-		  case ' ':
-		    flags |= FL_SPACE;
-		    continue;
-		  case '-':
-		    flags |= FL_LPAD;
-		    continue;
-		  case '#':
-		    flags |= FL_ALT;
-		    continue;
-		}
+	if (plan) {
+	    op = plan++;
+	    if (op->lit_len)
+		my_puts (op->lit, op->lit_len, stream);
+	    if (op->conv == '\0') goto ret;
+	    if (op->conv == '%') continue;
+	} else {
+	    for (;;) {
+		/* Send runs of literal text as a single block */
+		pnt = fmt;
+		while ((c = *fmt) != '\0' && c != '%')
+		    fmt++;
+		if (fmt != pnt)
+		    my_puts (pnt, fmt - pnt, stream);
+		if (!c) goto ret;
+		fmt++;
+		if (*fmt != '%') break;
+		fmt++;
+		my_putc ('%', stream);
 	    }
 
-	    if (flags < FL_LONG) {
-		if (c >= '0' && c <= '9') {
-		    c -= '0';
-		    if (flags & FL_PREC) {
-			prec = 10*prec + c;
-			continue;
-		    }
-		    width = 10*width + c;
-		    flags |= FL_WIDTH;
-		    continue;
-		}
-		if (c == '*') {
-		    if (flags & FL_PREC) {
-			prec = va_arg(ap, int);
-			if (prec < 0)
-			    prec = 0;
-		    } else {
-			width = va_arg(ap, int);
-			flags |= FL_WIDTH;
-			if (width < 0) {
-			    width = -width;
-			    flags |= FL_LPAD;
-			}
-		    }
-		    continue;
-		}
-		if (c == '.') {
-		    if (flags & FL_PREC)
-			goto ret;
-		    flags |= FL_PREC;
-		    continue;
-		}
-	    }
+	    fmt = printf_parse (fmt, &fmt_op);
+	    if (!fmt) goto ret;
+	    op = &fmt_op;
+	}
 
-	    if (c == 'l') {
-		if (flags & FL_LONG) {
-#ifdef _WANT_IO_C99_FORMATS
-		is_long_long:
-#endif
-		    flags |= FL_REPD_TYPE;
-		}
-#ifdef _WANT_IO_C99_FORMATS
-	    is_long:
-#endif
-		flags |= FL_LONG;
-		flags &= ~FL_SHORT;
-		continue;
-	    }
+	flags = op->flags;
+	width = op->width;
+	prec = op->prec;
+	c = op->conv;
 
-	    if (c == 'h') {
-		if (flags & FL_SHORT)
-		    flags |= FL_REPD_TYPE;
-#ifdef _WANT_IO_C99_FORMATS
-	    is_short:
-#endif
-		flags |= FL_SHORT;
-		flags &= ~FL_LONG;
-		continue;
+	if (op->star & STAR_WIDTH) {
+	    width = va_arg(ap, int);
+	    if (width < 0) {
+		width = -width;
+		flags |= FL_LPAD;
 	    }
-
-#ifdef _WANT_IO_C99_FORMATS
-#define CHECK_INT_SIZE(letter, type) do {			\
-		if (c == letter) {				\
-		    if (sizeof(type) == sizeof(int))		\
-			continue;				\
-		    if (sizeof(type) == sizeof(long))		\
-			goto is_long;				\
-		    if (sizeof(type) == sizeof(long long))	\
-			goto is_long_long;			\
-		    if (sizeof(type) == sizeof(short))		\
-			goto is_short;				\
-		} \
-	    } while(0)
-
-	    CHECK_INT_SIZE('j', intmax_t);
-	    CHECK_INT_SIZE('z', size_t);
-	    CHECK_INT_SIZE('t', ptrdiff_t);
-#endif
-
-	    break;
-	} while ( (c = *fmt++) != 0);
+	}
+	if (op->star & STAR_PREC) {
+	    prec = va_arg(ap, int);
+	    if (prec < 0)
+		prec = 0;
+	}
 
 	/* Only a format character is valid.	*/
 
@@ -753,11 +820,11 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap)
 		    width--;
 		}
 	    }
-	    while (size) {
-		my_putc (*pnt++, stream);
-		if (width) width -= 1;
-		size -= 1;
-	    }
+	    my_puts (pnt, size, stream);
+	    if ((size_t) width > size)
+		width -= size;
+	    else
+		width = 0;
 	    goto tail;
 	}
 
@@ -883,9 +950,60 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap)
   ret:
     return stream_len;
 #undef my_putc
+#undef my_puts
+}
+
+int vfprintf (FILE * stream, const char *fmt, va_list ap)
+{
+    return printf_run (stream, fmt, NULL, ap);
 }
 
 #ifndef vfprintf
+
+/*
+ * Pre-parsed formats are only provided by the default printf
+ */
+int
+printf_plan_compile (struct printf_op *plan, size_t nops, const char *fmt)
+{
+    struct printf_op op;
+    size_t n = 0;
+    char c;
+
+    do {
+	const char *lit = fmt;
+
+	while ((c = *fmt) != '\0' && c != '%')
+	    fmt++;
+
+	op = (struct printf_op) { .lit = lit, .lit_len = fmt - lit };
+
+	if (c) {
+	    if (fmt[1] == '%') {
+		/* Keep one '%' in the literal text */
+		op.lit_len++;
+		op.conv = '%';
+		fmt += 2;
+	    } else {
+		fmt = printf_parse (fmt + 1, &op);
+		if (!fmt)
+		    return -1;
+	    }
+	}
+	if (n < nops)
+	    plan[n] = op;
+	n++;
+    } while (c);
+
+    return n;
+}
+
+int
+vfprintf_plan (FILE * stream, const struct printf_op *plan, va_list ap)
+{
+    return printf_run (stream, NULL, plan, ap);
+}
+
 #ifdef HAVE_ALIAS_ATTRIBUTE
 __strong_reference(vfprintf, __d_vfprintf);
 #else
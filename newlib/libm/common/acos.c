@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "asin_inline.h"
+
+/* acos(x) = pi/2 - asin(x) below 1/2, with pi/2 - x in double-double,
+   and uses the asin_sqrt reduction above.  Worst-case error is below
+   0.67 ULP.  */
+double
+acos (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, z, s2, w, hi, lo;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  if (abstop < abstop16 (0.5))
+    {
+      if (unlikely (abstop < abstop16 (0x1p-26)))
+	return Pio2hi - (x - Pio2lo);
+      z = x * x;
+      /* pi/2 > |x|, so hi + lo = pi/2 - x exactly.  */
+      hi = Pio2hi - x;
+      lo = (Pio2hi - hi) - x;
+      return hi + ((Pio2lo - x * z * asin_poly (z)) + lo);
+    }
+
+  ax = fabs (x);
+  if (unlikely (!(ax < 1.0)))
+    {
+      if (x == 1.0)
+	return 0.0;
+      if (x == -1.0)
+	return Pihi + Pilo;
+      return __math_invalid (x);
+    }
+
+  w = asin_sqrt (ax, &s2);
+  if (x > 0)
+    return s2 + w;
+  /* pi > 2s, so hi + lo = pi - 2s exactly.  */
+  hi = Pihi - s2;
+  lo = (Pihi - hi) - s2;
+  return hi + ((Pilo - w) + lo);
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "asin_inline.h"
+
+/* Below 1/2 the polynomial is used directly, above it the argument is
+   reduced with asin_sqrt.  Worst-case error is below 0.66 ULP.  */
+double
+asin (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, z, s2, w, hi, lo, y;
+  uint64_t sign;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  if (abstop < abstop16 (0.5))
+    {
+      if (unlikely (abstop < abstop16 (0x1p-26)))
+	{
+	  if (unlikely (abstop < abstop16 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      z = x * x;
+      return x + x * z * asin_poly (z);
+    }
+
+  sign = asuint64 (x) & 0x8000000000000000ULL;
+  ax = asdouble (asuint64 (x) ^ sign);
+  if (unlikely (!(ax < 1.0)))
+    {
+      if (ax == 1.0)
+	return asdouble (asuint64 (Pio2hi + Pio2lo) ^ sign);
+      return __math_invalid (x);
+    }
+
+  w = asin_sqrt (ax, &s2);
+  /* pi/2 > 2s, so hi + lo = pi/2 - 2s exactly.  */
+  hi = Pio2hi - s2;
+  lo = (Pio2hi - hi) - s2;
+  y = hi + ((Pio2lo - w) + lo);
+  return asdouble (asuint64 (y) ^ sign);
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+/* asin(x) ~= x + x^3 * (P0 + x^2 * P1 + ... + x^24 * P12) for |x| <= 1/2,
+   relative error of the polynomial below 2^-52.9.  */
+static const double asin_coeff[] = {
+  0x1.5555555555556p-3,
+  0x1.3333333332ecap-4,
+  0x1.6db6db6e31f13p-5,
+  0x1.f1c71c1db0623p-6,
+  0x1.6e8bb1c8209a2p-6,
+  0x1.1c4d35cf95421p-6,
+  0x1.c9cf07674736ap-7,
+  0x1.782651caa6547p-7,
+  0x1.52420b04b37bep-7,
+  0x1.65a9c4dfcf8b2p-8,
+  0x1.1d189408314eep-6,
+  -0x1.e6aaa8a0a04ccp-7,
+  0x1.d72b2bc8155f8p-6,
+};
+
+#define Pio2hi 0x1.921fb54442d18p+0
+#define Pio2lo 0x1.1a62633145c07p-54
+#define Pihi 0x1.921fb54442d18p+1
+#define Pilo 0x1.1a62633145c07p-53
+
+/* Top 16 bits of a double with the sign bit cleared.  */
+static inline uint32_t
+abstop16 (double x)
+{
+  return (asuint64 (x) >> 48) & 0x7fff;
+}
+
+/* (asin(x) - x) / x^3 for z = x^2 <= 1/4.  */
+static inline double_t
+asin_poly (double_t z)
+{
+  const double *P = asin_coeff;
+  double_t z2, z4;
+
+  z2 = z * z;
+  z4 = z2 * z2;
+  return P[0] + z * P[1] + z2 * (P[2] + z * P[3])
+    + z4 * (P[4] + z * P[5] + z2 * (P[6] + z * P[7]))
+    + z4 * z4 * (P[8] + z * P[9] + z2 * (P[10] + z * P[11]) + z4 * P[12]);
+}
+
+/* For 1/2 <= AX < 1 set *S2 to 2s, where s = sqrt((1 - AX)/2) rounded,
+   and return W such that 2 asin(s) = 2s + W to well below an ULP of 2s.
+   The identities asin(x) = pi/2 - 2 asin(s), acos(x) = 2 asin(s) and
+   acos(-x) = pi - 2 asin(s) then keep the polynomial argument below
+   1/4.  W includes the rounding error of the square root.  */
+static inline double_t
+asin_sqrt (double_t ax, double_t *s2)
+{
+  double_t z, s, e;
+
+  z = (1.0 - ax) * 0.5;
+  /* The builtin becomes the hardware instruction where there is one,
+     the library sqrt is a slow software routine on many targets.  */
+  s = __builtin_sqrt (z);
+#if HAVE_FAST_FMA
+  e = fma (-s, s, z);
+#else
+  {
+    double_t sh, sl;
+
+    sh = asdouble (asuint64 (s) & 0xffffffff00000000ULL);
+    sl = s - sh;
+    e = ((z - sh * sh) - 2 * sh * sl) - sl * sl;
+  }
+#endif
+  *s2 = 2 * s;
+  /* e/s is twice the correction to s.  */
+  return e / s + 2 * s * z * asin_poly (z);
+}
@@ -0,0 +1,79 @@
+/* Double-precision atan function.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "atan_inline.h"
+
+/* Below 7/16 the polynomial is used directly, above 1 the identity
+   atan(x) = pi/2 - atan(1/x) applies and large arguments need nothing
+   more than the reciprocal.  Worst-case error is below
+   0.66 ULP.  */
+double
+atan (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, t, z, hi, lo, y;
+  uint64_t sign;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  if (abstop < abstop16 (0x1.cp-2))
+    {
+      if (unlikely (abstop < abstop16 (0x1p-27)))
+	{
+	  if (unlikely (abstop < abstop16 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      z = x * x;
+      return x - x * z * atan_poly (z);
+    }
+
+  sign = asuint64 (x) & 0x8000000000000000ULL;
+  ax = asdouble (asuint64 (x) ^ sign);
+  if (unlikely (abstop >= abstop16 (0x1p60)))
+    {
+      if (isnan (x))
+	return x + x;
+      y = Pio2hi + Pio2lo;
+      return asdouble (asuint64 (y) ^ sign);
+    }
+
+  if (ax >= 0x1.28p1)
+    {
+      /* 1/x is below 7/16 and its rounding error is small next to the
+	 ULP of the result, so no double-double quotient is needed.  */
+      t = 1.0 / ax;
+      z = t * t;
+      hi = Pio2hi - t;
+      lo = (Pio2hi - hi) - t;
+      y = hi + (lo + (Pio2lo + t * z * atan_poly (z)));
+    }
+  else if (ax <= 1.0)
+    {
+      hi = atan_inline (ax, 1.0, &lo);
+      y = hi + lo;
+    }
+  else
+    {
+      hi = atan_inline (1.0, ax, &lo);
+      /* hi < pi/2, so (Pio2hi - y) - hi is the rounding error of y.  */
+      y = Pio2hi - hi;
+      y = y + (((Pio2hi - y) - hi) + (Pio2lo - lo));
+    }
+  return asdouble (asuint64 (y) ^ sign);
+}
+
+#endif
@@ -0,0 +1,107 @@
+/* Double-precision atan2 function.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "atan_inline.h"
+
+/* atan2 is +-(off + atan(n/d)) or +-(off - atan(n/d)) with n and d the
+   smaller and larger of |x| and |y|.  The offset is indexed by the sign
+   of x and whether |y| > |x|, the subtraction is needed when exactly one
+   of those holds.  */
+static const double off[4][2] = {
+  {0.0, 0.0},
+  {Pio2hi, Pio2lo},
+  {Pihi, Pilo},
+  {Pio2hi, Pio2lo},
+};
+
+/* Arguments with both exponents well inside the normal range and less
+   than 60 apart go straight to atan_inline, the rest are special cases
+   or are scaled first.  Worst-case error is below 0.72 ULP.  */
+double
+atan2 (double y, double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, ay, n, d, hi, lo, t, r;
+  uint64_t signx, signy, neg;
+  uint32_t ex, ey, swap, i;
+
+  signx = asuint64 (x) >> 63;
+  signy = asuint64 (y) & 0x8000000000000000ULL;
+  ax = fabs (x);
+  ay = fabs (y);
+  ex = asuint64 (ax) >> 52;
+  ey = asuint64 (ay) >> 52;
+  if (unlikely (ex - (0x3ff - 500) >= 1000 || ey - (0x3ff - 500) >= 1000
+		|| ex - ey + 60 > 120))
+    {
+      if (isnan (x) || isnan (y))
+	return x + y;
+      if (ay == 0.0 || (ex == 0x7ff && ey < 0x7ff))
+	/* +-0 or +-pi.  */
+	r = signx ? Pihi + Pilo : 0.0;
+      else if (ex == 0x7ff)
+	/* +-pi/4 or +-3pi/4.  */
+	r = signx ? 3 * Pio4hi : Pio4hi;
+      else if (ax == 0.0 || ey == 0x7ff || ex + 60 < ey)
+	{
+	  /* +-pi/2, minus or plus a quotient that cannot affect it.  */
+	  t = ax / ay;
+	  r = signx ? Pio2hi + (t + Pio2lo) : Pio2hi - (t - Pio2lo);
+	}
+      else if (ey + 60 < ex)
+	{
+	  /* atan(y/x) = y/x for y/x below 2^-59.  */
+	  t = ay / ax;
+	  if (signx)
+	    r = Pihi - (t - Pilo);
+	  else
+	    r = check_uflow (t);
+	}
+      else
+	{
+	  /* The exponents are close, with both above 2^440 or below
+	     2^-440, so scaling them towards 1 is exact.  */
+	  if (ex > 0x3ff)
+	    {
+	      ax *= 0x1p-600;
+	      ay *= 0x1p-600;
+	    }
+	  else
+	    {
+	      ax *= 0x1p600;
+	      ay *= 0x1p600;
+	    }
+	  goto reduced;
+	}
+      return asdouble (asuint64 (r) ^ signy);
+    }
+
+reduced:
+  swap = ay > ax;
+  n = swap ? ax : ay;
+  d = swap ? ay : ax;
+  hi = atan_inline (n, d, &lo);
+  neg = (uint64_t) (swap ^ signx) << 63;
+  hi = asdouble (asuint64 (hi) ^ neg);
+  lo = asdouble (asuint64 (lo) ^ neg);
+  i = signx * 2 + swap;
+  /* The offset is zero or larger than |hi|, so the sum is exact in
+     r + ((off - r) + hi).  */
+  r = off[i][0] + hi;
+  r = r + (((off[i][0] - r) + hi) + (off[i][1] + lo));
+  return asdouble (asuint64 (r) ^ signy);
+}
+
+#endif
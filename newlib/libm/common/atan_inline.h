@@ -0,0 +1,122 @@
+/* Shared argument reduction and polynomial for atan and atan2.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+/* atan(x) ~= x - x^3 * (aT0 + x^2 * aT1 + ... + x^20 * aT10) for
+   |x| <= 7/16, from fdlibm.  */
+static const double aT[] = {
+  0x1.555555555550dp-2,
+  -0x1.999999998ebc4p-3,
+  0x1.24924920083ffp-3,
+  -0x1.c71c6fe231671p-4,
+  0x1.745cdc54c206ep-4,
+  -0x1.3b0f2af749a6dp-4,
+  0x1.10d66a0d03d51p-4,
+  -0x1.dde2d52defd9ap-5,
+  0x1.97b4b24760debp-5,
+  -0x1.2b4442c6a6c2fp-5,
+  0x1.0ad3ae322da11p-6,
+};
+
+#define Atan05hi 0x1.dac670561bb4fp-2
+#define Atan05lo 0x1.a2b7f222f65e2p-56
+#define Pio4hi 0x1.921fb54442d18p-1
+#define Pio4lo 0x1.1a62633145c07p-55
+#define Pio2hi 0x1.921fb54442d18p+0
+#define Pio2lo 0x1.1a62633145c07p-54
+#define Pihi 0x1.921fb54442d18p+1
+#define Pilo 0x1.1a62633145c07p-53
+
+/* Top 16 bits of a double with the sign bit cleared.  */
+static inline uint32_t
+abstop16 (double x)
+{
+  return (asuint64 (x) >> 48) & 0x7fff;
+}
+
+/* (x - atan(x)) / x^3 for z = x^2 <= (7/16)^2.  */
+static inline double_t
+atan_poly (double_t z)
+{
+  double_t z2, z4;
+
+  z2 = z * z;
+  z4 = z2 * z2;
+  return aT[0] + z * aT[1] + z2 * (aT[2] + z * aT[3])
+    + z4 * (aT[4] + z * aT[5] + z2 * (aT[6] + z * aT[7]))
+    + z4 * z4 * (aT[8] + z * aT[9] + z2 * aT[10]);
+}
+
+/* Return hi and set *LO such that hi + lo = atan(N/D) to well below an
+   ULP of hi, for 0 <= N <= D with D and N/D not too close to the ends
+   of the exponent range.  The quotient is reduced by atan(1/2) or
+   atan(1) as in fdlibm, but with exact numerators and the division
+   carried in double-double, so atan2 does not round twice.  */
+static inline double_t
+atan_inline (double_t n, double_t d, double_t *lo)
+{
+  double_t num, den, dlo, a, alo, inv, t, e, tlo, z, hi;
+
+  if (n < 0x1.cp-2 * d)
+    {
+      /* n/d < 7/16.  */
+      num = n;
+      den = d;
+      dlo = 0.0;
+      a = 0.0;
+      alo = 0.0;
+    }
+  else if (n < 0x1.6p-1 * d)
+    {
+      /* atan(1/2) + atan((2n - d)/(2d + n)) for n/d < 11/16, the
+	 numerator is exact and den + dlo = 2d + n.  */
+      num = 2 * n - d;
+      den = 2 * d + n;
+      dlo = (2 * d - den) + n;
+      a = Atan05hi;
+      alo = Atan05lo;
+    }
+  else
+    {
+      /* atan(1) + atan((n - d)/(n + d)).  */
+      num = n - d;
+      den = d + n;
+      dlo = (d - den) + n;
+      a = Pio4hi;
+      alo = Pio4lo;
+    }
+  inv = 1.0 / den;
+  t = num * inv;
+  /* e = num - t * den exactly, so t + tlo = num / (den + dlo).  */
+#if HAVE_FAST_FMA
+  e = fma (-t, den, num);
+#else
+  {
+    double_t th, tl, dh, dl;
+
+    th = asdouble (asuint64 (t) & 0xffffffff00000000ULL);
+    tl = t - th;
+    dh = asdouble (asuint64 (den) & 0xffffffff00000000ULL);
+    dl = den - dh;
+    e = (((num - th * dh) - th * dl) - tl * dh) - tl * dl;
+  }
+#endif
+  tlo = (e - t * dlo) * inv;
+  z = t * t;
+  /* a > |t| when a is not zero, so the sum is exact in hi + lo.  */
+  hi = a + t;
+  *lo = ((a - hi) + t) + (alo + (tlo - z * tlo - t * z * atan_poly (z)));
+  return hi;
+}
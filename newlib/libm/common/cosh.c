@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include "exp_inline.h"
+
+/* Top 16 bits of a double with the sign bit cleared.  */
+static inline uint32_t
+abstop16 (double x)
+{
+  return (asuint64 (x) >> 48) & 0x7fff;
+}
+
+/* The halves of e^|x| and e^-|x| come from one argument reduction and
+   are added in double-double.  Worst-case error is below 0.52 ULP.  */
+double
+cosh (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, r, t1, t2, s1, s2, hi, lo;
+  uint64_t ki, sb1, sb2;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  ax = asdouble (asuint64 (x) & 0x7fffffffffffffffULL);
+  if (unlikely (abstop < abstop16 (0x1p-54)))
+    /* Avoid spurious underflow for tiny x.  */
+    return WANT_ROUNDING ? 1.0 + ax : 1.0;
+  if (unlikely (abstop >= abstop16 (22.0)))
+    {
+      if (abstop >= abstop16 (512.0))
+	{
+	  if (abstop >= abstop16 (INFINITY))
+	    return ax + ax;
+	  if (abstop >= abstop16 (1024.0))
+	    return __math_oflow (0);
+	  /* e^|x|/2 may overflow, scale it as in exp.  */
+	  ki = exp_reduce (ax, &r);
+	  t1 = exp_kernel (ki, r, &sb1);
+	  s1 = asdouble (sb1 - (1010ull << 52));
+	  return check_oflow (eval_as_double (0x1p1009 * (s1 + s1 * t1)));
+	}
+      /* e^-|x| is below the rounding error of e^|x|.  */
+      ki = exp_reduce (ax, &r);
+      t1 = exp_kernel (ki, r, &sb1);
+      s1 = asdouble (sb1 - (1ull << 52));
+      return s1 + s1 * t1;
+    }
+
+  ki = exp_reduce (ax, &r);
+  t1 = exp_kernel (ki, r, &sb1);
+  t2 = exp_kernel (-ki, -r, &sb2);
+  /* Halve the scales, which are normal and at least 2^-33.  */
+  s1 = asdouble (sb1 - (1ull << 52));
+  s2 = asdouble (sb2 - (1ull << 52));
+  /* s1 >= s2, so hi + lo = s1 + s2 exactly.  */
+  hi = s1 + s2;
+  lo = s1 - hi + s2;
+  return hi + (lo + (s1 * t1 + s2 * t2));
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include "exp_inline.h"
+
+/* expm1(x) ~= x + x^2/2 + x^3 * (P0 + x * P1 + ... + x^6 * P6) for
+   |x| < 1/16, relative error of the polynomial below 2^-52.  */
+static const double P[] = {
+  0x1.5555555555555p-3,
+  0x1.5555555555658p-5,
+  0x1.111111111116fp-7,
+  0x1.6c16c15be808bp-10,
+  0x1.a01a01945523ep-13,
+  0x1.a02218f697a20p-16,
+  0x1.71e41cc0ad3f6p-19,
+};
+
+/* Top 12 bits of a double (sign and exponent bits).  */
+static inline uint32_t
+top12 (double x)
+{
+  return asuint64 (x) >> 52;
+}
+
+/* Small arguments use a polynomial, the others the table driven exp
+   kernel with the subtraction of 1 done exactly.
+   Worst-case error is below 0.56 ULP.  */
+double
+expm1 (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t r, x2, x4, p, tmp, scale, hi, lo, t, y;
+  uint64_t ki, sbits;
+  uint32_t abstop;
+
+  abstop = top12 (x) & 0x7ff;
+  if (abstop < top12 (0x1p-4))
+    {
+      if (unlikely (abstop < top12 (0x1p-54)))
+	{
+	  if (unlikely (abstop < top12 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      x2 = x * x;
+      x4 = x2 * x2;
+      p = P[0] + x * P[1] + x2 * (P[2] + x * P[3])
+	  + x4 * (P[4] + x * P[5] + x2 * P[6]);
+      return x + (0.5 * x2 + x * x2 * p);
+    }
+  if (unlikely (abstop >= top12 (512.0)))
+    {
+      if (abstop >= top12 (INFINITY) && asuint64 (x) != asuint64 (-INFINITY))
+	return 1.0 + x;
+      if (asuint64 (x) >> 63)
+	/* e^x < 2^-738, so only the rounding direction is in doubt.  */
+	return WANT_ROUNDING ? 0x1p-1000 - 1.0 : -1.0;
+      if (abstop >= top12 (1024.0))
+	return __math_oflow (0);
+      /* 1 is far below the rounding error of e^x, and scale may
+	 overflow, so scale it as in exp.  */
+      ki = exp_reduce (x, &r);
+      tmp = exp_kernel (ki, r, &sbits);
+      scale = asdouble (sbits - (1009ull << 52));
+      return check_oflow (eval_as_double (0x1p1009 * (scale + scale * tmp)));
+    }
+
+  ki = exp_reduce (x, &r);
+  tmp = exp_kernel (ki, r, &sbits);
+  scale = asdouble (sbits);
+  /* e^x - 1 = (scale - 1) + scale * tmp where hi + lo = scale - 1.  */
+  hi = scale - 1.0;
+  t = hi - scale;
+  lo = (scale - (hi - t)) - (1.0 + t);
+  y = hi + (lo + scale * tmp);
+  return y;
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Errno-free entry points
+ *
+ * __fast_<name> returns what <name> does but reports errors through
+ * the floating point exception flags alone, leaving errno untouched,
+ * so callers which never look at errno don't pay for it. Special
+ * cases stay out of line, leaving only the kernel on the common path.
+ *
+ * Each entry point is generated from fast_entry.c.in by the
+ * fast_entries table in meson.build. The generated file compiles the
+ * regular source of the function again under the __fast_ name with
+ * __MATH_FAST_ENTRY defined, which turns off WANT_ERRNO in
+ * math_config.h and sends the special cases to the __math_fast_
+ * error helpers in math_err_fast.c and math_errf_fast.c.
+ *
+ * The obsolete fdlibm code sets errno deep inside its kernels, so
+ * when it is selected the entry point calls the fdlibm function
+ * through FAST_ENTRY_FALLBACK and restores errno afterwards.
+ */
+
+#ifndef _FAST_ENTRY_H_
+#define _FAST_ENTRY_H_
+
+#include <math.h>
+#include <errno.h>
+
+#define __MATH_FAST_ENTRY
+
+#define FAST_ENTRY_FALLBACK(type, name, params, call)	\
+type							\
+name params						\
+{							\
+  int __err = errno;					\
+  type __ret = call;					\
+  errno = __err;					\
+  return __ret;						\
+}
+
+#endif /* _FAST_ENTRY_H_ */
@@ -11,6 +11,9 @@
  * ====================================================
  */
 
+#ifndef _FDLIBM_H_
+#define _FDLIBM_H_
+
 /* REDHAT LOCAL: Include files.  */
 #include <math.h>
 #include <sys/types.h>
@@ -405,3 +408,4 @@ typedef union {
 
 #endif  /* _COMPLEX_H */
 
+#endif /* _FDLIBM_H_ */
@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include "log_inline.h"
+
+/* 1/ln(10) in two parts, the first with few enough bits that a 21 bit
+   number times it is exact.  */
+#define InvLn10hi 0x1.bcb7b152p-2
+#define InvLn10lo 0x1.b9438ca9aadd5p-36
+
+/* log10(x) = log(x)/ln(10), using the extra precise log from pow and
+   scaling it in double-double arithmetic.
+   Worst-case error is below 0.51 ULP.  */
+double
+log10 (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t hi, lo, y, ylo;
+  uint64_t ix;
+  uint32_t top;
+
+  ix = asuint64 (x);
+  top = ix >> 52;
+  if (unlikely (top - 0x001 >= 0x7ff - 0x001))
+    {
+      /* x < 0x1p-1022 or inf or nan.  */
+      if (ix * 2 == 0)
+	return __math_divzero (1);
+      if (ix == asuint64 ((double) INFINITY)) /* log10(inf) == inf.  */
+	return x;
+      if ((top & 0x800) || (top & 0x7ff) == 0x7ff)
+	return __math_invalid (x);
+      /* x is subnormal, normalize it.  */
+      ix = asuint64 (x * 0x1p52);
+      ix -= 52ULL << 52;
+    }
+  /* Fix sign of zero with downward rounding when x==1.  */
+  if (WANT_ROUNDING && unlikely (ix == asuint64 (1.0)))
+    return 0;
+
+  hi = log_inline (ix, &lo);
+#if HAVE_FAST_FMA
+  y = hi * InvLn10hi;
+  ylo = fma (hi, InvLn10hi, -y);
+#else
+  double_t yhi;
+
+  yhi = asdouble (asuint64 (hi) & -1ULL << 32);
+  y = yhi * InvLn10hi;
+  ylo = (hi - yhi) * InvLn10hi;
+#endif
+  ylo += hi * InvLn10lo + lo * InvLn10hi;
+  return y + ylo;
+}
+
+#endif
@@ -37,12 +37,16 @@
 /* Correct special case results in non-nearest rounding modes.  */
 # define WANT_ROUNDING 1
 #endif
-#ifdef _IEEE_LIBM
+#if defined(_IEEE_LIBM) || defined(__MATH_FAST_ENTRY)
+/* The __fast_ entry points never set errno; see fast_entry.h.  */
 # define WANT_ERRNO 0
-# define _LIB_VERSION _IEEE_
 #else
 /* Set errno according to ISO C with (math_errhandling & MATH_ERRNO) != 0.  */
 # define WANT_ERRNO 1
+#endif
+#ifdef _IEEE_LIBM
+# define _LIB_VERSION _IEEE_
+#else
 # define _LIB_VERSION _POSIX_
 #endif
 #ifndef WANT_ERRNO_UFLOW
@@ -279,10 +283,12 @@ eval_as_double (double x)
 
 #ifdef __GNUC__
 # define NOINLINE __attribute__ ((noinline))
+# define COLD __attribute__ ((cold))
 # define likely(x) __builtin_expect (!!(x), 1)
 # define unlikely(x) __builtin_expect (x, 0)
 #else
 # define NOINLINE
+# define COLD
 # define likely(x) (x)
 # define unlikely(x) (x)
 #endif
@@ -294,32 +300,48 @@ eval_as_double (double x)
 # define HIDDEN
 #endif
 
+#if defined(__MATH_FAST_ENTRY) && !defined(_IEEE_LIBM)
+/* The library helpers below set errno, so the __fast_ entry points
+   call a second copy without it; see fast_entry.h.  */
+# define __math_oflowf __math_fast_oflowf
+# define __math_uflowf __math_fast_uflowf
+# define __math_divzerof __math_fast_divzerof
+# define __math_invalidf __math_fast_invalidf
+# define __math_xflowf __math_fast_xflowf
+# define __math_oflow __math_fast_oflow
+# define __math_uflow __math_fast_uflow
+# define __math_divzero __math_fast_divzero
+# define __math_invalid __math_fast_invalid
+# define __math_xflow __math_fast_xflow
+#endif
+
 /* Error handling tail calls for special cases, with a sign argument.
-   The sign of the return value is set if the argument is non-zero.  */
+   The sign of the return value is set if the argument is non-zero.
+   These are marked cold so callers keep them off the fast path.  */
 
 /* The result overflows.  */
-HIDDEN float __math_oflowf (uint32_t);
+HIDDEN COLD float __math_oflowf (uint32_t);
 /* The result underflows to 0 in nearest rounding mode.  */
-HIDDEN float __math_uflowf (uint32_t);
+HIDDEN COLD float __math_uflowf (uint32_t);
 /* The result underflows to 0 in some directed rounding mode only.  */
-HIDDEN float __math_may_uflowf (uint32_t);
+HIDDEN COLD float __math_may_uflowf (uint32_t);
 /* Division by zero.  */
-HIDDEN float __math_divzerof (uint32_t);
+HIDDEN COLD float __math_divzerof (uint32_t);
 /* The result overflows.  */
-HIDDEN double __math_oflow (uint32_t);
+HIDDEN COLD double __math_oflow (uint32_t);
 /* The result underflows to 0 in nearest rounding mode.  */
-HIDDEN double __math_uflow (uint32_t);
+HIDDEN COLD double __math_uflow (uint32_t);
 /* The result underflows to 0 in some directed rounding mode only.  */
-HIDDEN double __math_may_uflow (uint32_t);
+HIDDEN COLD double __math_may_uflow (uint32_t);
 /* Division by zero.  */
-HIDDEN double __math_divzero (uint32_t);
+HIDDEN COLD double __math_divzero (uint32_t);
 
 /* Error handling using input checking.  */
 
 /* Invalid input unless it is a quiet NaN.  */
-HIDDEN float __math_invalidf (float);
+HIDDEN COLD float __math_invalidf (float);
 /* Invalid input unless it is a quiet NaN.  */
-HIDDEN double __math_invalid (double);
+HIDDEN COLD double __math_invalid (double);
 
 /* Error handling using output checking, only for errno setting.  */
 
@@ -458,6 +480,38 @@ extern const struct pow_log_data
   struct {double invc, pad, logc, logctail;} tab[1 << POW_LOG_TABLE_BITS];
 } __pow_log_data HIDDEN;
 
+#define SINCOS_TAN_POLY_ORDER 13
+extern const struct sincos_data
+{
+  double invpio2;
+  double shift;
+#if HAVE_FAST_FMA
+  double pio2[3];	/* pi/2 split into three doubles.  */
+#else
+  double pio2_1;	/* First 33 bits of pi/2.  */
+  double pio2_1t;	/* pi/2 - pio2_1.  */
+#endif
+  double pio4;
+  double pio4lo;
+  double sin_poly[6];
+  double cos_poly[6];
+  double tan_poly[SINCOS_TAN_POLY_ORDER];
+} __sincos_data HIDDEN;
+
+/* The array functions run their inner loop over this many elements,
+   then recompute the ones outside the fast path with the scalar
+   function.  */
+#define VMATH_BLOCK 64
+
+/* A where MASK is all ones, B where it is zero.  The array functions
+   use this rather than ?:, which compilers turn back into a branch
+   around the computation of A or B and then cannot vectorize.  */
+static inline double
+vmath_select (uint64_t mask, double a, double b)
+{
+  return asdouble ((asuint64 (a) & mask) | (asuint64 (b) & ~mask));
+}
+
 #if WANT_ERRNO
 HIDDEN double
 __math_with_errno (double y, int e);
@@ -469,10 +523,10 @@ __math_with_errnof (float y, int e);
 #define __math_with_errnof(x, e) (x)
 #endif
 
-HIDDEN double
+HIDDEN COLD double
 __math_xflow (uint32_t sign, double y);
 
-HIDDEN float
+HIDDEN COLD float
 __math_xflowf (uint32_t sign, float y);
 
 #endif
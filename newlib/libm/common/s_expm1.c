@@ -142,6 +142,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include "math_config.h"
 
 #ifndef _DOUBLE_IS_32BITS
@@ -263,3 +264,4 @@ Q5  =  -2.01099218183624371326e-07; /* BE8AFDB7 6E09C32D */
 }
 
 #endif /* _DOUBLE_IS_32BITS */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,56 @@
+/* Double-precision sin function.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "sincos.h"
+
+/* Arguments below pi/4 go straight to the polynomial, others are reduced
+   by a multiple of pi/2 which selects sin or cos of the remainder.
+   Worst-case error is below 1 ULP, as with the fdlibm kernels.  */
+double
+sin (double x)
+{
+  double y[2];
+  int n;
+
+  if (abstop12 (x) < abstop12 (Pio4) || fabs (x) <= Pio4)
+    {
+      if (unlikely (abstop12 (x) < abstop12 (0x1p-26)))
+	{
+	  if (unlikely (abstop12 (x) < abstop12 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      return sin_poly (x);
+    }
+
+  if (unlikely (abstop12 (x) >= abstop12 (INFINITY)))
+    return __math_invalid (x);
+
+  n = reduce (x, y);
+  switch (n & 3)
+    {
+    case 0:
+      return sin_poly_tail (y[0], y[1]);
+    case 1:
+      return cos_poly (y[0], y[1]);
+    case 2:
+      return -sin_poly_tail (y[0], y[1]);
+    default:
+      return -cos_poly (y[0], y[1]);
+    }
+}
+
+#endif
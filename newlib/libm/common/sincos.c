@@ -0,0 +1,72 @@
+/* Double-precision sincos function.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "sincos.h"
+
+/* Both results share one range reduction.  */
+void
+sincos (double x, double *sinp, double *cosp)
+{
+  double y[2];
+  double s, c;
+  int n;
+
+  if (abstop12 (x) < abstop12 (Pio4) || fabs (x) <= Pio4)
+    {
+      if (unlikely (abstop12 (x) < abstop12 (0x1p-27)))
+	{
+	  if (unlikely (abstop12 (x) < abstop12 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  *sinp = x;
+	  *cosp = 1.0;
+	  return;
+	}
+      *sinp = sin_poly (x);
+      *cosp = cos_poly (x, 0.0);
+      return;
+    }
+
+  if (unlikely (abstop12 (x) >= abstop12 (INFINITY)))
+    {
+      *sinp = *cosp = __math_invalid (x);
+      return;
+    }
+
+  n = reduce (x, y);
+  s = sin_poly_tail (y[0], y[1]);
+  c = cos_poly (y[0], y[1]);
+  switch (n & 3)
+    {
+    case 0:
+      *sinp = s;
+      *cosp = c;
+      break;
+    case 1:
+      *sinp = c;
+      *cosp = -s;
+      break;
+    case 2:
+      *sinp = -s;
+      *cosp = -c;
+      break;
+    default:
+      *sinp = -c;
+      *cosp = s;
+      break;
+    }
+}
+
+#endif
@@ -0,0 +1,220 @@
+/* Shared range reduction and kernels for sin, cos, sincos and tan.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+#define InvPio2 __sincos_data.invpio2
+#define Shift __sincos_data.shift
+#define Pio4 __sincos_data.pio4
+#define Pio4lo __sincos_data.pio4lo
+#define S1 __sincos_data.sin_poly[0]
+#define S2 __sincos_data.sin_poly[1]
+#define S3 __sincos_data.sin_poly[2]
+#define S4 __sincos_data.sin_poly[3]
+#define S5 __sincos_data.sin_poly[4]
+#define S6 __sincos_data.sin_poly[5]
+#define C1 __sincos_data.cos_poly[0]
+#define C2 __sincos_data.cos_poly[1]
+#define C3 __sincos_data.cos_poly[2]
+#define C4 __sincos_data.cos_poly[3]
+#define C5 __sincos_data.cos_poly[4]
+#define C6 __sincos_data.cos_poly[5]
+#define T __sincos_data.tan_poly
+
+/* Top 12 bits of the double representation with the sign bit cleared.  */
+static inline uint32_t
+abstop12 (double x)
+{
+  return (asuint64 (x) >> 52) & 0x7ff;
+}
+
+/* Reduce X, with |X| < 2^20, to Y[0] + Y[1] in [-pi/4, pi/4] and return
+   the quadrant using a single multiply and subtract by pi/2.  *OK is
+   cleared for arguments so close to a multiple of pi/2 that too many
+   bits cancel for the reduced value to be exact.  */
+static inline int
+reduce_medium (double x, double *y, int *ok)
+{
+  double_t kd, fn, r, y0;
+  uint64_t ki;
+
+  kd = eval_as_double (x * InvPio2 + Shift);
+  ki = asuint64 (kd);
+  fn = kd - Shift;
+#if HAVE_FAST_FMA
+  /* x - fn * pio2[0] is a multiple of 2^-53 below 1, so exact.  */
+  r = fma (-fn, __sincos_data.pio2[0], x);
+  y0 = fma (-fn, __sincos_data.pio2[1], r);
+  /* |fn * pio2[1]| < 2^-34, so r - y0 is exact from here.  */
+  *ok = fn == 0.0 || abstop12 (y0) >= abstop12 (0x1p-32);
+  y[0] = y0;
+  y[1] = fma (-fn, __sincos_data.pio2[2],
+	      fma (-fn, __sincos_data.pio2[1], r - y0));
+#else
+  double_t w;
+
+  r = x - fn * __sincos_data.pio2_1;
+  w = fn * __sincos_data.pio2_1t;
+  y0 = r - w;
+  /* The 85 bit pi/2 leaves enough good bits unless more than 16
+     of them cancelled.  */
+  *ok = abstop12 (y0) + 16 >= abstop12 (x);
+  y[0] = y0;
+  y[1] = (r - y0) - w;
+#endif
+  return (int) ki;
+}
+
+/* Reduce X, with pi/4 < |X| < inf, to Y[0] + Y[1] in [-pi/4, pi/4] and
+   return the quadrant.  Arguments that reduce_medium cannot handle go
+   through __ieee754_rem_pio2, which reduces huge arguments using its
+   table of 2/pi.  */
+static inline int
+reduce (double x, double *y)
+{
+  if (likely (abstop12 (x) < abstop12 (0x1p20)))
+    {
+      int n, ok;
+
+      n = reduce_medium (x, y, &ok);
+      if (likely (ok))
+	return n;
+    }
+  return __ieee754_rem_pio2 (x, y);
+}
+
+/* sin(X) for |X| <= pi/4.  Evaluation is split to give superscalar and
+   fma machines some independent work.  */
+static inline double
+sin_poly (double x)
+{
+  double_t z, w, r, v;
+
+  z = x * x;
+  w = z * z;
+  r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+  v = z * x;
+  return x + v * (S1 + z * r);
+}
+
+/* sin(X + Y) for |X + Y| <= pi/4, where Y is the tail of X.  */
+static inline double
+sin_poly_tail (double x, double y)
+{
+  double_t z, w, r, v;
+
+  z = x * x;
+  w = z * z;
+  r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+  v = z * x;
+  return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+/* cos(X + Y) for |X + Y| <= pi/4, where Y is the tail of X (or 0).
+   1 - x^2/2 is computed with an error compensation term so the result
+   stays below 1 ULP up to pi/4.  */
+static inline double
+cos_poly (double x, double y)
+{
+  double_t z, w, r, hz;
+
+  z = x * x;
+  w = z * z;
+  r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+  hz = 0.5 * z;
+  w = 1.0 - hz;
+  return w + (((1.0 - w) - hz) + (z * r - x * y));
+}
+
+/* tan(X + Y) for |X + Y| <= pi/4, or -1/tan(X + Y) when ODD is set.
+   Above 0.6744 the identity tan(pi/4 - x) = (1 - tan x)/(1 + tan x)
+   keeps the polynomial argument small.  */
+static inline double
+tan_poly (double x, double y, int odd)
+{
+  double_t z, r, v, w, s, a;
+  int big, sign = 0;
+
+  big = (asuint64 (x) >> 32 & 0x7fffffff) >= 0x3fe59428;	/* |x| >= 0.6744 */
+  if (big)
+    {
+      sign = x < 0;
+      if (sign)
+	{
+	  x = -x;
+	  y = -y;
+	}
+      x = (Pio4 - x) + (Pio4lo - y);
+      y = 0.0;
+    }
+  z = x * x;
+  w = z * z;
+  /* Odd and even terms of x^5 * (T1 + x^2 * T2 + ...) in w = x^4.  */
+  r = T[1] + w * (T[3] + w * (T[5] + w * (T[7] + w * (T[9] + w * T[11]))));
+  v = z * (T[2] + w * (T[4] + w * (T[6] + w * (T[8] + w * (T[10]
+							+ w * T[12])))));
+  s = z * x;
+  r = y + z * (s * (r + v) + y) + s * T[0];
+  w = x + r;
+  if (big)
+    {
+      s = 1 - 2 * odd;
+      v = s - 2.0 * (x + (r - w * w / (w + s)));
+      return sign ? -v : v;
+    }
+  if (!odd)
+    return w;
+  /* -1/(x + r) directly has up to 2 ULP error, so correct for the
+     rounding of both the sum and the division.  */
+  a = -1.0 / w;
+#if HAVE_FAST_FMA
+  v = r - (w - x);		/* w + v = x + r */
+  return a + a * (fma (a, w, 1.0) + a * v);
+#else
+  {
+    double_t w0, a0;
+
+    w0 = asdouble (asuint64 (w) & 0xffffffff00000000ULL);
+    v = r - (w0 - x);		/* w0 + v = x + r */
+    a0 = asdouble (asuint64 (a) & 0xffffffff00000000ULL);
+    return a0 + a * (1.0 + a0 * w0 + a0 * v);
+  }
+#endif
+}
+
+/* Sine and cosine of X for the array functions.  Every finite X below
+   2^20 takes the same path, with the quadrant applied by masks rather
+   than branches; *OK is cleared when X needs the scalar function.  */
+static inline void
+sincos_lane (double x, double *sinp, double *cosp, int *ok)
+{
+  double y[2];
+  double_t s, c, t;
+  uint64_t odd, sign;
+  int n, fast, reduced;
+
+  fast = abstop12 (x) < abstop12 (0x1p20);
+  x = vmath_select (-(uint64_t) fast, x, 0.0);
+  n = reduce_medium (x, y, &reduced);
+  s = sin_poly_tail (y[0], y[1]);
+  c = cos_poly (y[0], y[1]);
+  s = vmath_select (-(uint64_t) (abstop12 (x) < abstop12 (0x1p-26)), x, s);
+  odd = -(uint64_t) (n & 1);
+  sign = (uint64_t) (n & 2) << 62;
+  t = vmath_select (odd, c, s);
+  c = vmath_select (odd, -s, c);
+  *sinp = asdouble (asuint64 (t) ^ sign);
+  *cosp = asdouble (asuint64 (c) ^ sign);
+  *ok = fast & reduced;
+}
@@ -0,0 +1,76 @@
+/* Data definitions for sin, cos, sincos and tan.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "math_config.h"
+
+const struct sincos_data __sincos_data = {
+  .invpio2 = 0x1.45f306dc9c883p-1,
+  .shift = 0x1.8p52,
+#if HAVE_FAST_FMA
+  /* The first product is exact under fma, the other two only have to
+     be accurate relative to the reduced argument.  */
+  .pio2 = {
+    0x1.921fb54442d18p+0,
+    0x1.1a62633145c07p-54,
+    -0x1.f1976b7ed8fbcp-110,
+  },
+#else
+  /* n * pio2_1 is exact for |n| < 2^20, the remainder is good to
+     85 bits.  */
+  .pio2_1 = 0x1.921fb544p+0,
+  .pio2_1t = 0x1.0b4611a626331p-34,
+#endif
+  .pio4 = 0x1.921fb54442d18p-1,
+  .pio4lo = 0x1.1a62633145c07p-55,
+  /* sin(x) ~= x + x^3 * (S1 + x^2 * S2 + ... + x^10 * S6) on [-pi/4, pi/4],
+     |error| < 2^-58.  */
+  .sin_poly = {
+    -1.66666666666666324348e-01,
+    8.33333333332248946124e-03,
+    -1.98412698298579493134e-04,
+    2.75573137070700676789e-06,
+    -2.50507602534068634195e-08,
+    1.58969099521155010221e-10,
+  },
+  /* cos(x) ~= 1 - x^2 / 2 + x^4 * (C1 + x^2 * C2 + ... + x^10 * C6) on
+     [-pi/4, pi/4], |error| < 2^-58.  */
+  .cos_poly = {
+    4.16666666666666019037e-02,
+    -1.38888888888741095749e-03,
+    2.48015872894767294178e-05,
+    -2.75573143513906633035e-07,
+    2.08757232129817482790e-09,
+    -1.13596475577881948265e-11,
+  },
+  /* tan(x) ~= x + x^3 * (T0 + x^2 * T1 + ... + x^24 * T12) on
+     [0, 0.67434], |error| < 2^-59.2.  */
+  .tan_poly = {
+    3.33333333333334091986e-01,
+    1.33333333333201242699e-01,
+    5.39682539762260521377e-02,
+    2.18694882948595424599e-02,
+    8.86323982359930005737e-03,
+    3.59207910759131235356e-03,
+    1.45620945432529025516e-03,
+    5.88041240820264096874e-04,
+    2.46463134818469906812e-04,
+    7.81794442939557092300e-05,
+    7.14072491382608190305e-05,
+    -1.85586374855275456654e-05,
+    2.59073051863633712884e-05,
+  },
+};
+
+#endif
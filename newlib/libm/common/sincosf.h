@@ -172,3 +172,35 @@ reduce_large (uint32_t xi, int *np)
   *np = n;
   return x * pi63;
 }
+
+/* Sine and cosine of Y for the array functions.  Every |Y| < 120 takes
+   the same path, with the quadrant applied by masks rather than
+   branches; *OK is cleared when Y needs the scalar function.  */
+static inline void
+sincosf_lane (float y, float *sinp, float *cosp, int *ok)
+{
+  const sincos_t *p = &__sincosf_table[0];
+  double x, x2, x3, x4, x5, x6, s, c, t;
+  uint64_t odd, sign;
+  int n, fast;
+
+  fast = abstop12 (y) < abstop12 (120.0f);
+  x = reduce_fast ((double) asfloat (asuint (y) & -(uint32_t) fast), p, &n);
+  x2 = x * x;
+  x3 = x2 * x;
+  x4 = x2 * x2;
+  x5 = x3 * x2;
+  x6 = x4 * x2;
+  s = x + x3 * p->s1;
+  s = s + x5 * (p->s2 + x2 * p->s3);
+  c = p->c0 + x2 * p->c1;
+  c = c + x4 * p->c2;
+  c = c + x6 * (p->c3 + x2 * p->c4);
+  odd = -(uint64_t) (n & 1);
+  sign = (uint64_t) (n & 2) << 62;
+  t = vmath_select (odd, c, s);
+  c = vmath_select (odd, -s, c);
+  *sinp = asdouble (asuint64 (t) ^ sign);
+  *cosp = asdouble (asuint64 (c) ^ sign);
+  *ok = fast;
+}
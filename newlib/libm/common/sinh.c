@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include "exp_inline.h"
+
+/* sinh(x) ~= x + x^3 * (P0 + x^2 * P1 + ... + x^10 * P5) for |x| < 1/2,
+   relative error of the polynomial below 2^-53.  */
+static const double P[] = {
+  0x1.5555555555555p-3,
+  0x1.1111111111120p-7,
+  0x1.a01a01a00ef0fp-13,
+  0x1.71de3a84a10c3p-19,
+  0x1.ae63a07779c78p-26,
+  0x1.6267cf434f12cp-33,
+};
+
+/* Top 16 bits of a double with the sign bit cleared.  */
+static inline uint32_t
+abstop16 (double x)
+{
+  return (asuint64 (x) >> 48) & 0x7fff;
+}
+
+/* For |x| >= 1/2 the halves of e^|x| and e^-|x| come from one argument
+   reduction and are subtracted in double-double, so the cancellation
+   costs no accuracy.  Worst-case error is below 0.6 ULP.  */
+double
+sinh (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t ax, r, z, z2, p, t1, t2, s1, s2, hi, lo, y;
+  uint64_t ki, sb1, sb2, sign;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  if (abstop < abstop16 (0.5))
+    {
+      if (unlikely (abstop < abstop16 (0x1p-26)))
+	{
+	  if (unlikely (abstop < abstop16 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      z = x * x;
+      z2 = z * z;
+      p = P[0] + z * P[1] + z2 * (P[2] + z * P[3]) + z2 * z2 * (P[4] + z * P[5]);
+      return x + x * z * p;
+    }
+
+  sign = asuint64 (x) & 0x8000000000000000ULL;
+  ax = asdouble (asuint64 (x) ^ sign);
+  if (unlikely (abstop >= abstop16 (22.0)))
+    {
+      if (abstop >= abstop16 (512.0))
+	{
+	  if (abstop >= abstop16 (INFINITY))
+	    return x + x;
+	  if (abstop >= abstop16 (1024.0))
+	    return __math_oflow (sign != 0);
+	  /* e^|x|/2 may overflow, scale it as in exp.  */
+	  ki = exp_reduce (ax, &r);
+	  t1 = exp_kernel (ki, r, &sb1);
+	  s1 = asdouble (sb1 - (1010ull << 52));
+	  y = 0x1p1009 * (s1 + s1 * t1);
+	  return check_oflow (eval_as_double (asdouble (asuint64 (y) ^ sign)));
+	}
+      /* e^-|x| is below the rounding error of e^|x|.  */
+      ki = exp_reduce (ax, &r);
+      t1 = exp_kernel (ki, r, &sb1);
+      s1 = asdouble (sb1 - (1ull << 52));
+      y = s1 + s1 * t1;
+      return asdouble (asuint64 (y) ^ sign);
+    }
+
+  ki = exp_reduce (ax, &r);
+  t1 = exp_kernel (ki, r, &sb1);
+  t2 = exp_kernel (-ki, -r, &sb2);
+  /* Halve the scales, which are normal and at least 2^-33.  */
+  s1 = asdouble (sb1 - (1ull << 52));
+  s2 = asdouble (sb2 - (1ull << 52));
+  /* s1 > s2, so hi + lo = s1 - s2 exactly.  */
+  hi = s1 - s2;
+  lo = s1 - hi - s2;
+  y = hi + (lo + (s1 * t1 - s2 * t2));
+  return asdouble (asuint64 (y) ^ sign);
+}
+
+#endif
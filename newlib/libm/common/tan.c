@@ -0,0 +1,46 @@
+/* Double-precision tan function.
+ *
+ * ====================================================
+ * Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+ *
+ * Developed at SunPro, a Sun Microsystems, Inc. business.
+ * Permission to use, copy, modify, and distribute this
+ * software is freely granted, provided that this notice
+ * is preserved.
+ * ====================================================
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "sincos.h"
+
+/* Arguments are reduced by a multiple of pi/2; odd quadrants return
+   -1/tan of the remainder.  Worst-case error is below 1 ULP, as with
+   the fdlibm kernel.  */
+double
+tan (double x)
+{
+  double y[2];
+  int n;
+
+  if (abstop12 (x) < abstop12 (Pio4) || fabs (x) <= Pio4)
+    {
+      if (unlikely (abstop12 (x) < abstop12 (0x1p-27)))
+	{
+	  if (unlikely (abstop12 (x) < abstop12 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      return tan_poly (x, 0.0, 0);
+    }
+
+  if (unlikely (abstop12 (x) >= abstop12 (INFINITY)))
+    return __math_invalid (x);
+
+  n = reduce (x, y);
+  return tan_poly (y[0], y[1], n & 1);
+}
+
+#endif
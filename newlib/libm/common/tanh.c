@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include "exp_inline.h"
+
+/* tanh(x) ~= x + x^3 * (P0 + x^2 * P1 + ... + x^14 * P7) for |x| < 1/4,
+   relative error of the polynomial below 2^-53.  */
+static const double P[] = {
+  -0x1.5555555555555p-2,
+  0x1.11111111110a0p-3,
+  -0x1.ba1ba1b9f660bp-5,
+  0x1.664f485d6d4d4p-6,
+  -0x1.226e22fa6f453p-7,
+  0x1.d6c9f446c47cbp-9,
+  -0x1.7c2ad98792f89p-10,
+  0x1.17cd5b9306c04p-11,
+};
+
+/* Top 16 bits of a double with the sign bit cleared.  */
+static inline uint32_t
+abstop16 (double x)
+{
+  return (asuint64 (x) >> 48) & 0x7fff;
+}
+
+/* For |x| >= 1/4, tanh|x| = 1 - 2/(e^2|x| + 1) with the denominator in
+   double-double and the rounding error of the division corrected.
+   Worst-case error is below 0.56 ULP.  */
+double
+tanh (double x)
+{
+  /* double_t for better performance on targets with FLT_EVAL_METHOD==2.  */
+  double_t r, z, z2, z4, p, tmp, scale, dhi, dlo, q, e, hi, lo, y;
+  uint64_t ki, sbits, sign;
+  uint32_t abstop;
+
+  abstop = abstop16 (x);
+  if (abstop < abstop16 (0.25))
+    {
+      if (unlikely (abstop < abstop16 (0x1p-27)))
+	{
+	  if (unlikely (abstop < abstop16 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      z = x * x;
+      z2 = z * z;
+      z4 = z2 * z2;
+      p = P[0] + z * P[1] + z2 * (P[2] + z * P[3])
+	  + z4 * (P[4] + z * P[5] + z2 * (P[6] + z * P[7]));
+      return x + x * z * p;
+    }
+
+  sign = asuint64 (x) & 0x8000000000000000ULL;
+  if (unlikely (abstop >= abstop16 (22.0)))
+    {
+      if (abstop >= abstop16 (INFINITY) && (asuint64 (x) << 12) != 0)
+	return x + x;
+      /* 1 - tanh|x| < 2^-62.  */
+      y = WANT_ROUNDING ? 1.0 - 0x1p-1000 : 1.0;
+      return asdouble (asuint64 (y) ^ sign);
+    }
+
+  ki = exp_reduce (2.0 * asdouble (asuint64 (x) ^ sign), &r);
+  tmp = exp_kernel (ki, r, &sbits);
+  scale = asdouble (sbits);
+  /* hi + lo = e^2|x| and dhi + dlo = e^2|x| + 1, where hi > 1.  */
+  hi = scale + scale * tmp;
+  lo = scale - hi + scale * tmp;
+  dhi = hi + 1.0;
+  dlo = hi - dhi + 1.0 + lo;
+  q = 2.0 / dhi;
+  /* e = 2 - q * (dhi + dlo), with q * dhi computed exactly.  */
+#if HAVE_FAST_FMA
+  e = fma (-q, dhi, 2.0);
+#else
+  double_t qhi, qlo, dhhi, dhlo;
+
+  qhi = asdouble (asuint64 (q) & -1ULL << 32);
+  qlo = q - qhi;
+  dhhi = asdouble (asuint64 (dhi) & -1ULL << 32);
+  dhlo = dhi - dhhi;
+  e = 2.0 - qhi * dhhi - qhi * dhlo - qlo * dhhi - qlo * dhlo;
+#endif
+  e -= q * dlo;
+  /* tanh|x| = 1 - q - e/(dhi + dlo) with hi + lo = 1 - q exactly.  */
+  hi = 1.0 - q;
+  lo = 1.0 - hi - q;
+  y = hi + (lo - e * (0.5 * q));
+  return asdouble (asuint64 (y) ^ sign);
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "sincos.h"
+
+/* cos of each element of IN, stored to OUT, which may be IN.  The
+   loop has no branches so it can be vectorized; elements sincos_lane cannot
+   handle are passed to cos once the block is done.  */
+void
+vcos (double *out, const double *in, size_t n)
+{
+  double arg[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any, ok;
+
+  for (; n; n -= m, in += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  double x = in[i], s, c;
+
+	  sincos_lane (x, &s, &c, &ok);
+	  arg[i] = x;
+	  out[i] = c;
+	  slow[i] = !ok;
+	  any |= !ok;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = cos (arg[i]);
+    }
+}
+
+#else
+
+void
+vcos (double *out, const double *in, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = cos (in[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,129 @@
+/* Double-precision e^x over an array.
+   Copyright (c) 2018 Arm Ltd.  All rights reserved.
+
+   SPDX-License-Identifier: BSD-3-Clause
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. The name of the company may not be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+   THIS SOFTWARE IS PROVIDED BY ARM LTD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+   WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+   IN NO EVENT SHALL ARM LTD BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+   TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+
+/* The exp algorithm with the special cases taken out of the loop.  */
+
+#define N (1 << EXP_TABLE_BITS)
+#define InvLn2N __exp_data.invln2N
+#define NegLn2hiN __exp_data.negln2hiN
+#define NegLn2loN __exp_data.negln2loN
+#define Shift __exp_data.shift
+#define T __exp_data.tab
+#define C2 __exp_data.poly[5 - EXP_POLY_ORDER]
+#define C3 __exp_data.poly[6 - EXP_POLY_ORDER]
+#define C4 __exp_data.poly[7 - EXP_POLY_ORDER]
+#define C5 __exp_data.poly[8 - EXP_POLY_ORDER]
+#define C6 __exp_data.poly[9 - EXP_POLY_ORDER]
+
+/* exp of each element of IN, stored to OUT, which may be IN.  The loop
+   has no branches so it can be vectorized; elements with |x| >= 512 or
+   nan are passed to exp once the block is done.  */
+void
+vexp (double *out, const double *in, size_t n)
+{
+  double arg[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any;
+
+  for (; n; n -= m, in += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  uint64_t ki, idx, top, sbits;
+	  double_t kd, z, r, r2, scale, tail, tmp;
+	  double x = in[i], xd;
+	  int big = (asuint64 (x) >> 52 & 0x7ff) >= asuint64 (512.0) >> 52;
+
+	  xd = vmath_select (-(uint64_t) big, 0.0, x);
+	  arg[i] = x;
+
+	  /* x = ln2/N*k + r, with int k and r in [-ln2/2N, ln2/2N].  */
+	  z = InvLn2N * xd;
+#if TOINT_INTRINSICS
+	  kd = roundtoint (z);
+	  ki = converttoint (z);
+#elif EXP_USE_TOINT_NARROW
+	  kd = eval_as_double (z + Shift);
+	  ki = asuint64 (kd) >> 16;
+	  kd = (double_t) (int32_t) ki;
+#else
+	  kd = eval_as_double (z + Shift);
+	  ki = asuint64 (kd);
+	  kd -= Shift;
+#endif
+	  r = xd + kd * NegLn2hiN + kd * NegLn2loN;
+	  /* 2^(k/N) ~= scale * (1 + tail).  */
+	  idx = 2 * (ki % N);
+	  top = ki << (52 - EXP_TABLE_BITS);
+	  tail = asdouble (T[idx]);
+	  sbits = T[idx + 1] + top;
+	  /* exp(x) = 2^(k/N) * exp(r) ~= scale + scale * (tail + exp(r) - 1).  */
+	  r2 = r * r;
+#if EXP_POLY_ORDER == 4
+	  tmp = tail + r + r2 * C2 + r * r2 * (C3 + r * C4);
+#elif EXP_POLY_ORDER == 5
+	  tmp = tail + r + r2 * (C2 + r * C3) + r2 * r2 * (C4 + r * C5);
+#elif EXP_POLY_ORDER == 6
+	  tmp = tail + r + r2 * (0.5 + r * C3) + r2 * r2 * (C4 + r * C5 + r2 * C6);
+#endif
+	  scale = asdouble (sbits);
+	  out[i] = scale + scale * tmp;
+	  slow[i] = big;
+	  any |= big;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = exp (arg[i]);
+    }
+}
+
+#else
+
+#include <math.h>
+
+void
+vexp (double *out, const double *in, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = exp (in[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,117 @@
+/* Single-precision e^x over an array.
+   Copyright (c) 2017 Arm Ltd.  All rights reserved.
+
+   SPDX-License-Identifier: BSD-3-Clause
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. The name of the company may not be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+   THIS SOFTWARE IS PROVIDED BY ARM LTD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+   WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+   IN NO EVENT SHALL ARM LTD BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+   TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_FLOAT
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+
+/* The expf algorithm with the special cases taken out of the loop.  */
+
+#define N (1 << EXP2F_TABLE_BITS)
+#define InvLn2N __exp2f_data.invln2_scaled
+#define T __exp2f_data.tab
+#define C __exp2f_data.poly_scaled
+
+/* expf of each element of IN, stored to OUT, which may be IN.  The loop
+   has no branches so it can be vectorized; elements with |x| >= 88 or
+   nan are passed to expf once the block is done, so the results match
+   expf exactly.  */
+void
+vexpf (float *out, const float *in, size_t n)
+{
+  float arg[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any;
+
+  for (; n; n -= m, in += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  uint64_t ki, t;
+	  double_t kd, xd, z, r, r2, y, s;
+	  float x = in[i];
+	  uint32_t ix = asuint (x);
+	  int big = (ix >> 20 & 0x7ff) >= asuint (88.0f) >> 20;
+
+	  /* Big x is replaced by 0 with a mask, see vmath_select.  */
+	  xd = (double_t) asfloat (ix & ((uint32_t) big - 1));
+	  arg[i] = x;
+
+	  /* x*N/Ln2 = k + r with r in [-1/2, 1/2] and int k.  */
+	  z = InvLn2N * xd;
+#if TOINT_INTRINSICS
+	  kd = roundtoint (z);
+	  ki = converttoint (z);
+#else
+# define SHIFT __exp2f_data.shift
+	  kd = (double) (z + SHIFT);
+	  ki = asuint64 (kd);
+	  kd -= SHIFT;
+#endif
+	  r = z - kd;
+
+	  /* exp(x) = 2^(k/N) * 2^(r/N) ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+	  t = T[ki % N];
+	  t += ki << (52 - EXP2F_TABLE_BITS);
+	  s = asdouble (t);
+	  z = C[0] * r + C[1];
+	  r2 = r * r;
+	  y = C[2] * r + 1;
+	  y = z * r2 + y;
+	  y = y * s;
+	  out[i] = (float) y;
+	  slow[i] = big;
+	  any |= big;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = expf (arg[i]);
+    }
+}
+
+#else
+
+#include <math.h>
+
+void
+vexpf (float *out, const float *in, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = expf (in[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_FLOAT */
@@ -0,0 +1,144 @@
+/* Double-precision log(x) over an array.
+   Copyright (c) 2018 Arm Ltd.  All rights reserved.
+
+   SPDX-License-Identifier: BSD-3-Clause
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. The name of the company may not be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+   THIS SOFTWARE IS PROVIDED BY ARM LTD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+   WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+   IN NO EVENT SHALL ARM LTD BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+   TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+
+/* The table based part of the log algorithm; the inputs close to 1
+   which log handles with a separate polynomial are left to log along
+   with the special cases.  */
+
+#define T __log_data.tab
+#define T2 __log_data.tab2
+#define A __log_data.poly
+#define Ln2hi __log_data.ln2hi
+#define Ln2lo __log_data.ln2lo
+#define N (1 << LOG_TABLE_BITS)
+#define OFF 0x3fe6000000000000
+
+#if LOG_POLY1_ORDER == 10 || LOG_POLY1_ORDER == 11
+# define LO asuint64 (1.0 - 0x1p-5)
+# define HI asuint64 (1.0 + 0x1.1p-5)
+#elif LOG_POLY1_ORDER == 12
+# define LO asuint64 (1.0 - 0x1p-4)
+# define HI asuint64 (1.0 + 0x1.09p-4)
+#endif
+
+/* log of each element of IN, stored to OUT, which may be IN.  The loop
+   has no branches so it can be vectorized; elements close to 1, zero,
+   negative, subnormal and non-finite elements are passed to log once
+   the block is done, so the results match log exactly.  */
+void
+vlog (double *out, const double *in, size_t n)
+{
+  double arg[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any;
+
+  for (; n; n -= m, in += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  double_t w, z, r, r2, y, invc, logc, kd, hi, lo;
+	  uint64_t ix, iz, tmp;
+	  int k, j;
+	  double x = in[i];
+	  int special;
+
+	  ix = asuint64 (x);
+	  special = (ix - LO < HI - LO
+		     || (ix >> 48) - 0x0010 >= 0x7ff0 - 0x0010);
+	  /* Special x is replaced by 2.0 with masks, see vmath_select.  */
+	  ix = ((ix & ((uint64_t) special - 1))
+		| (asuint64 (2.0) & -(uint64_t) special));
+	  arg[i] = x;
+
+	  /* x = 2^k z; where z is in range [OFF,2*OFF) and exact.  */
+	  tmp = ix - OFF;
+	  j = (tmp >> (52 - LOG_TABLE_BITS)) % N;
+	  k = (int64_t) tmp >> 52; /* arithmetic shift */
+	  iz = ix - (tmp & 0xfffULL << 52);
+	  invc = T[j].invc;
+	  logc = T[j].logc;
+	  z = asdouble (iz);
+
+	  /* log(x) = log1p(z/c-1) + log(c) + k*Ln2.  */
+#if HAVE_FAST_FMA
+	  r = fma (z, invc, -1.0);
+#else
+	  r = (z - T2[j].chi - T2[j].clo) * invc;
+#endif
+	  kd = (double_t) k;
+
+	  /* hi + lo = r + log(c) + k*Ln2.  */
+	  w = kd * Ln2hi + logc;
+	  hi = w + r;
+	  lo = w - hi + r + kd * Ln2lo;
+
+	  /* log(x) = lo + (log1p(r) - r) + hi.  */
+	  r2 = r * r;
+#if LOG_POLY_ORDER == 6
+	  y = lo + r2 * A[0] + r * r2 * (A[1] + r * A[2] + r2 * (A[3] + r * A[4])) + hi;
+#elif LOG_POLY_ORDER == 7
+	  y = lo
+	      + r2 * (A[0] + r * A[1] + r2 * (A[2] + r * A[3])
+		      + r2 * r2 * (A[4] + r * A[5]))
+	      + hi;
+#endif
+	  out[i] = y;
+	  slow[i] = special;
+	  any |= special;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = log (arg[i]);
+    }
+}
+
+#else
+
+#include <math.h>
+
+void
+vlog (double *out, const double *in, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = log (in[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,118 @@
+/* Single-precision log over an array.
+   Copyright (c) 2017 Arm Ltd.  All rights reserved.
+
+   SPDX-License-Identifier: BSD-3-Clause
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. The name of the company may not be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+   THIS SOFTWARE IS PROVIDED BY ARM LTD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+   WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+   IN NO EVENT SHALL ARM LTD BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+   TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_FLOAT
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+
+/* The logf algorithm with the special cases taken out of the loop.  */
+
+#define T __logf_data.tab
+#define A __logf_data.poly
+#define Ln2 __logf_data.ln2
+#define N (1 << LOGF_TABLE_BITS)
+#define OFF 0x3f330000
+
+/* logf of each element of IN, stored to OUT, which may be IN.  The loop
+   has no branches so it can be vectorized; zero, negative, subnormal
+   and non-finite elements are passed to logf once the block is done,
+   so the results match logf exactly.  */
+void
+vlogf (float *out, const float *in, size_t n)
+{
+  float arg[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any;
+
+  for (; n; n -= m, in += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  double_t z, r, r2, y, y0, invc, logc;
+	  uint32_t ix, iz, tmp;
+	  int k, j;
+	  float x = in[i];
+	  int special;
+
+	  ix = asuint (x);
+	  special = ix - 0x00800000 >= 0x7f800000 - 0x00800000;
+	  /* Special x is replaced by 1.0 with masks, see vmath_select.  */
+	  ix = (ix & ((uint32_t) special - 1)) | (0x3f800000 & -(uint32_t) special);
+	  arg[i] = x;
+
+	  /* x = 2^k z; where z is in range [OFF,2*OFF] and exact.  */
+	  tmp = ix - OFF;
+	  j = (tmp >> (23 - LOGF_TABLE_BITS)) % N;
+	  k = (int32_t) tmp >> 23; /* arithmetic shift */
+	  iz = ix - (tmp & 0x1ff << 23);
+	  invc = T[j].invc;
+	  logc = T[j].logc;
+	  z = (double_t) asfloat (iz);
+
+	  /* log(x) = log1p(z/c-1) + log(c) + k*Ln2 */
+	  r = z * invc - 1;
+	  y0 = logc + (double_t) k * Ln2;
+	  r2 = r * r;
+	  y = A[1] * r + A[2];
+	  y = A[0] * r2 + y;
+	  y = y * r2 + (y0 + r);
+#if WANT_ROUNDING
+	  /* Fix sign of zero with downward rounding when x==1.  */
+	  y = vmath_select (-(uint64_t) (ix == 0x3f800000), 0.0, y);
+#endif
+	  out[i] = (float) y;
+	  slow[i] = special;
+	  any |= special;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = logf (arg[i]);
+    }
+}
+
+#else
+
+#include <math.h>
+
+void
+vlogf (float *out, const float *in, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = logf (in[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_FLOAT */
@@ -0,0 +1,170 @@
+/* Single-precision pow over an array.
+   Copyright (c) 2017-2018 Arm Ltd.  All rights reserved.
+
+   SPDX-License-Identifier: BSD-3-Clause
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+   3. The name of the company may not be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+   THIS SOFTWARE IS PROVIDED BY ARM LTD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+   WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+   IN NO EVENT SHALL ARM LTD BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+   TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_FLOAT
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+
+/* The powf algorithm for positive normal x, with every other case left
+   to powf itself.  */
+
+#define N (1 << POWF_LOG2_TABLE_BITS)
+#define T __powf_log2_data.tab
+#define A __powf_log2_data.poly
+#define OFF 0x3f330000
+
+/* log2(x) for positive normal x, scaled by POWF_SCALE.  */
+static inline double_t
+log2_inline (uint32_t ix)
+{
+  double_t z, r, r2, r4, p, q, y, y0, invc, logc;
+  uint32_t iz, top, tmp;
+  int k, i;
+
+  tmp = ix - OFF;
+  i = (tmp >> (23 - POWF_LOG2_TABLE_BITS)) % N;
+  top = tmp & 0xff800000;
+  iz = ix - top;
+  k = (int32_t) top >> (23 - POWF_SCALE_BITS); /* arithmetic shift */
+  invc = T[i].invc;
+  logc = T[i].logc;
+  z = (double_t) asfloat (iz);
+
+  /* log2(x) = log1p(z/c-1)/ln2 + log2(c) + k */
+  r = z * invc - 1;
+  y0 = logc + (double_t) k;
+  r2 = r * r;
+  y = A[0] * r + A[1];
+  p = A[2] * r + A[3];
+  r4 = r2 * r2;
+  q = A[4] * r + y0;
+  q = p * r2 + q;
+  y = y * r4 + q;
+  return y;
+}
+
+#undef N
+#undef T
+#define N (1 << EXP2F_TABLE_BITS)
+#define T __exp2f_data.tab
+
+/* 2^xd for |xd| < 126 (scaled by POWF_SCALE).  */
+static inline double_t
+exp2_inline (double_t xd)
+{
+  uint64_t ki, t;
+  double_t kd, z, r, r2, y, s;
+
+#if TOINT_INTRINSICS
+# define C __exp2f_data.poly_scaled
+  kd = roundtoint (xd);
+  ki = converttoint (xd);
+#else
+# define C __exp2f_data.poly
+# define SHIFT __exp2f_data.shift_scaled
+  kd = (double) (xd + SHIFT);
+  ki = asuint64 (kd);
+  kd -= SHIFT;
+#endif
+  r = xd - kd;
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  t = T[ki % N];
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = asdouble (t);
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1;
+  y = z * r2 + y;
+  y = y * s;
+  return y;
+}
+
+/* powf of each pair of elements of X and Y, stored to OUT, which may be
+   X or Y.  The loop has no branches so it can be vectorized; unless x is
+   positive and normal, y is non-zero and finite, and |y*log2(x)| < 126,
+   the pair is passed to powf once the block is done, so the results
+   match powf exactly.  */
+void
+vpowf (float *out, const float *x, const float *y, size_t n)
+{
+  float argx[VMATH_BLOCK], argy[VMATH_BLOCK];
+  unsigned char slow[VMATH_BLOCK];
+  size_t i, m;
+  int any;
+
+  for (; n; n -= m, x += m, y += m, out += m)
+    {
+      m = n < VMATH_BLOCK ? n : VMATH_BLOCK;
+      any = 0;
+      for (i = 0; i < m; i++)
+	{
+	  float xi = x[i], yi = y[i];
+	  uint32_t ix = asuint (xi), iy = asuint (yi);
+	  double_t ylogx;
+	  int special;
+
+	  argx[i] = xi;
+	  argy[i] = yi;
+	  special = (ix - 0x00800000 >= 0x7f800000 - 0x00800000
+		     || 2 * iy - 1 >= 2u * 0x7f800000 - 1);
+	  /* Special pairs are replaced by 1^0 with masks, see vmath_select.  */
+	  ix = (ix & ((uint32_t) special - 1)) | (0x3f800000 & -(uint32_t) special);
+	  iy &= (uint32_t) special - 1;
+	  ylogx = (double) asfloat (iy) * log2_inline (ix);
+	  special |= ((asuint64 (ylogx) >> 47 & 0xffff)
+		      >= asuint64 (126.0 * POWF_SCALE) >> 47);
+	  ylogx = vmath_select (-(uint64_t) special, 0.0, ylogx);
+	  out[i] = (float) exp2_inline (ylogx);
+	  slow[i] = special;
+	  any |= special;
+	}
+      if (unlikely (any))
+	for (i = 0; i < m; i++)
+	  if (slow[i])
+	    out[i] = powf (argx[i], argy[i]);
+    }
+}
+
+#else
+
+#include <math.h>
+
+void
+vpowf (float *out, const float *x, const float *y, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    out[i] = powf (x[i], y[i]);
+}
+
+#endif /* !__OBSOLETE_MATH_FLOAT */
@@ -36,6 +36,7 @@
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -113,3 +114,4 @@ __strong_reference(__ieee754_acos, acos);
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
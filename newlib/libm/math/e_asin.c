@@ -43,6 +43,7 @@
 
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -123,3 +124,4 @@ __strong_reference(__ieee754_asin, asin);
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -40,6 +40,7 @@
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -133,3 +134,4 @@ __strong_reference(__ieee754_atan2, atan2);
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
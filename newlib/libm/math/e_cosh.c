@@ -33,6 +33,7 @@
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include "math_config.h"
 
 #ifndef _DOUBLE_IS_32BITS
@@ -96,3 +97,4 @@ __strong_reference(__ieee754_cosh, cosh);
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -43,6 +43,7 @@
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -87,3 +88,4 @@ __strong_reference(cos, _cos);
 #endif
 
 #endif /* _DOUBLE_IS_32BITS */
+#endif /* __OBSOLETE_MATH_DOUBLE */
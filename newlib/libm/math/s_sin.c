@@ -81,6 +81,7 @@ QUICKREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifndef _DOUBLE_IS_32BITS
 
@@ -125,3 +126,4 @@ __strong_reference(sin, _sin);
 #endif
 
 #endif /* _DOUBLE_IS_32BITS */
+#endif /* __OBSOLETE_MATH_DOUBLE */
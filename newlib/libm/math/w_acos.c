@@ -64,6 +64,7 @@ MATHREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #if !defined(_IEEE_LIBM) || !defined(HAVE_ALIAS_ATTRIBUTE)
@@ -89,3 +90,4 @@ MATHREF
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
 #endif /* defined(_IEEE_LIBM) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
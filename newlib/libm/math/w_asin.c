@@ -68,6 +68,7 @@ MATHREF
 
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #ifndef _DOUBLE_IS_32BITS
@@ -93,3 +94,4 @@ MATHREF
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
 #endif
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -61,6 +61,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #ifndef _DOUBLE_IS_32BITS
@@ -78,3 +79,4 @@ PORTABILITY
 #endif
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -55,6 +55,7 @@ QUICKREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #if !defined(_IEEE_LIBM) || !defined(HAVE_ALIAS_ATTRIBUTE)
@@ -80,3 +81,4 @@ QUICKREF
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
 #endif
+#endif /* __OBSOLETE_MATH_DOUBLE */
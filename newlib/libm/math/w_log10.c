@@ -46,6 +46,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #ifndef _DOUBLE_IS_32BITS
@@ -77,3 +78,4 @@ PORTABILITY
 #endif
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -3,6 +3,7 @@
    sin and cos. */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 #include <math.h>
 
@@ -30,3 +31,4 @@ extern double _cos(double);
 }
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -60,6 +60,7 @@ QUICKREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 
 #ifndef _DOUBLE_IS_32BITS
@@ -85,3 +86,4 @@ QUICKREF
 #endif
 
 #endif /* defined(_DOUBLE_IS_32BITS) */
+#endif /* __OBSOLETE_MATH_DOUBLE */
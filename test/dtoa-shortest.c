@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+static const struct {
+	double	d;
+	const char *s;
+} dtests[] = {
+	{ 0.0, "0" },
+	{ -0.0, "-0" },
+	{ 1.0, "1" },
+	{ 0.1, "0.1" },
+	{ 0.3, "0.3" },
+	{ -2.5, "-2.5" },
+	{ 100.0, "100" },
+	{ 123.456, "123.456" },
+	{ 1234567.0, "1234567" },
+	{ 1e16, "1e+16" },
+	{ 1e21, "1e+21" },
+	{ 1e-7, "1e-07" },
+	{ 0.001, "0.001" },
+	{ 2.0/3.0, "0.6666666666666666" },
+	{ 5e-324, "5e-324" },
+	{ 1.7976931348623157e308, "1.7976931348623157e+308" },
+	{ INFINITY, "inf" },
+	{ -INFINITY, "-inf" },
+};
+
+static const struct {
+	float	f;
+	const char *s;
+} ftests[] = {
+	{ 0.1f, "0.1" },
+	{ 1.0f/3.0f, "0.33333334" },
+	{ 16777216.0f, "16777216" },
+	{ 1e10f, "1e+10" },
+	{ 1e-45f, "1e-45" },
+	{ 3.4028235e38f, "3.4028235e+38" },
+};
+
+static uint64_t seed = 0x123456789abcdef1ULL;
+
+static uint64_t
+next(void)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return seed;
+}
+
+int
+main(void)
+{
+	char	buf[64];
+	int	error = 0;
+	unsigned i;
+	int	len;
+
+	for (i = 0; i < sizeof(dtests)/sizeof(dtests[0]); i++) {
+		len = dtoa_shortest(dtests[i].d, buf, sizeof(buf));
+		if (strcmp(buf, dtests[i].s) != 0 || len != (int) strlen(dtests[i].s)) {
+			printf("dtoa_shortest(%a): got \"%s\" (%d) expected \"%s\"\n",
+			       dtests[i].d, buf, len, dtests[i].s);
+			error = 1;
+		}
+	}
+
+	for (i = 0; i < sizeof(ftests)/sizeof(ftests[0]); i++) {
+		len = ftoa_shortest(ftests[i].f, buf, sizeof(buf));
+		if (strcmp(buf, ftests[i].s) != 0 || len != (int) strlen(ftests[i].s)) {
+			printf("ftoa_shortest(%a): got \"%s\" (%d) expected \"%s\"\n",
+			       (double) ftests[i].f, buf, len, ftests[i].s);
+			error = 1;
+		}
+	}
+
+	/* Truncation follows snprintf */
+	memset(buf, 'x', sizeof(buf));
+	len = dtoa_shortest(123.456, buf, 4);
+	if (len != 7 || strcmp(buf, "123") != 0) {
+		printf("truncated: got \"%s\" (%d)\n", buf, len);
+		error = 1;
+	}
+	if (dtoa_shortest(0.1, NULL, 0) != 3) {
+		printf("NULL buffer length wrong\n");
+		error = 1;
+	}
+
+#ifdef _IO_FLOAT_EXACT
+	/* Everything must round trip */
+	for (i = 0; i < 10000; i++) {
+		union { uint64_t u; double d; } du;
+		union { uint32_t u; float f; } fu;
+		double	d;
+		float	f;
+
+		/* Start with the subnormal and normal boundaries */
+		if (i < 4)
+			du.u = (uint64_t[]) { 0x0000000000000003ULL, 0x000fffffffffffffULL,
+					      0x0010000000000000ULL, 0x7fefffffffffffffULL }[i];
+		else
+			du.u = next();
+		if (isfinite(du.d)) {
+			dtoa_shortest(du.d, buf, sizeof(buf));
+			d = strtod(buf, NULL);
+			if (memcmp(&d, &du.d, sizeof(d)) != 0) {
+				printf("%016llx -> \"%s\" -> %016llx\n", (unsigned long long) du.u, buf, (unsigned long long) *(uint64_t *) &d);
+				error = 1;
+			}
+		}
+		fu.u = (uint32_t) (next() >> 32);
+		if (isfinite(fu.f)) {
+			ftoa_shortest(fu.f, buf, sizeof(buf));
+			f = strtof(buf, NULL);
+			if (memcmp(&f, &fu.f, sizeof(f)) != 0) {
+				printf("%08lx -> \"%s\" -> %08lx\n", (unsigned long) fu.u, buf, (unsigned long) *(uint32_t *) &f);
+				error = 1;
+			}
+		}
+	}
+#endif
+	return error;
+}
@@ -0,0 +1,391 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Measure the largest error, in units in the last place, of log10,
+ * log1p, expm1, sinh, cosh, tanh, asin, acos, atan and atan2 over
+ * random arguments from a few ranges for each. The reference values
+ * come from series evaluated in long double, so this only runs where
+ * long double is wider than double. Building with
+ * -Dnewlib-obsolete-math-double=true measures the fdlibm versions
+ * instead, which are held to a looser bound.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+
+#if LDBL_MANT_DIG >= DBL_MANT_DIG + 10
+
+#ifndef ULP_SWEEP_COUNT
+#define ULP_SWEEP_COUNT	10000
+#endif
+
+#ifdef __OBSOLETE_MATH_DOUBLE
+#define MAX_ULP		2.5
+#else
+#define MAX_ULP		1.0
+#endif
+
+typedef long double ld;
+
+/* ln2_hi has 40 bits so that k * ln2_hi is exact */
+static const ld ln2_hi = 0xb17217f7d1p-40L;
+static const ld ln2_lo = 7.371002565167798899886995037620593651e-13L;
+static const ld ln10 = 2.30258509299404568401799145468436421L;
+static const ld pi = 3.14159265358979323846264338327950288L;
+
+static ld
+abs_ref(ld x)
+{
+	return x < 0 ? -x : x;
+}
+
+static ld
+pow2_ref(long k)
+{
+	ld b = k < 0 ? 0.5L : 2.0L;
+	ld r = 1;
+	unsigned long n = k < 0 ? -k : k;
+
+	for (; n; n >>= 1, b *= b)
+		if (n & 1)
+			r *= b;
+	return r;
+}
+
+static ld
+exp_ref(ld x)
+{
+	long k = (long) (x / (ln2_hi + ln2_lo) + (x < 0 ? -0.5L : 0.5L));
+	ld r = (x - k * ln2_hi) - k * ln2_lo;
+	ld p = 1;
+	int i;
+
+	for (i = 30; i > 0; i--)
+		p = 1 + r * p / i;
+	return p * pow2_ref(k);
+}
+
+static ld
+expm1_ref(ld x)
+{
+	ld p = 1;
+	int i;
+
+	if (abs_ref(x) >= 0.5L)
+		return exp_ref(x) - 1;
+	for (i = 30; i > 1; i--)
+		p = 1 + x * p / i;
+	return x * p;
+}
+
+/* 2 atanh(s) = log((1 + s) / (1 - s)) */
+static ld
+atanh2_ref(ld s)
+{
+	ld z = s * s;
+	ld p = 0;
+	int i;
+
+	for (i = 81; i > 0; i -= 2)
+		p = 1.0L / i + z * p;
+	return 2 * s * p;
+}
+
+static ld
+log_ref(ld x)
+{
+	long e = 0;
+
+	while (x >= 0x1p64L) {
+		x *= 0x1p-64L;
+		e += 64;
+	}
+	while (x < 0x1p-64L) {
+		x *= 0x1p64L;
+		e -= 64;
+	}
+	while (x > 1.4142135623730950488L) {
+		x *= 0.5L;
+		e++;
+	}
+	while (x < 0.70710678118654752440L) {
+		x *= 2;
+		e--;
+	}
+	return e * ln2_hi + (e * ln2_lo + atanh2_ref((x - 1) / (x + 1)));
+}
+
+static ld
+log10_ref(ld x)
+{
+	return log_ref(x) / ln10;
+}
+
+static ld
+log1p_ref(ld x)
+{
+	if (abs_ref(x) < 0.5L)
+		return atanh2_ref(x / (2 + x));
+	return log_ref(1 + x);
+}
+
+static ld
+sinh_ref(ld x)
+{
+	ld a = abs_ref(x), e, p = 1;
+	int i;
+
+	if (a < 0.5L) {
+		for (i = 31; i > 1; i -= 2)
+			p = 1 + x * x * p / (i * (i - 1));
+		return x * p;
+	}
+	e = exp_ref(a);
+	return (x < 0 ? -0.5L : 0.5L) * (e - 1 / e);
+}
+
+static ld
+cosh_ref(ld x)
+{
+	ld e = exp_ref(abs_ref(x));
+
+	return 0.5L * (e + 1 / e);
+}
+
+static ld
+tanh_ref(ld x)
+{
+	ld e = expm1_ref(2 * abs_ref(x));
+
+	return (x < 0 ? -1 : 1) * e / (e + 2);
+}
+
+static ld
+sqrt_ref(ld a)
+{
+	ld y;
+
+	if (a == 0)
+		return 0;
+	y = sqrt((double) a);
+	y = (y + a / y) / 2;
+	return (y + a / y) / 2;
+}
+
+static ld
+atan_ref(ld t)
+{
+	ld z, p = 0;
+	int i;
+
+	if (t < 0)
+		return -atan_ref(-t);
+	if (t > 1)
+		return pi / 2 - atan_ref(1 / t);
+	/* Halve the angle twice, leaving |t| <= tan(pi/16) */
+	for (i = 0; i < 2; i++)
+		t = t / (1 + sqrt_ref(1 + t * t));
+	z = t * t;
+	for (i = 61; i > 0; i -= 2)
+		p = 1.0L / i - z * p;
+	return 4 * t * p;
+}
+
+static ld
+asin_ref(ld x)
+{
+	if (abs_ref(x) == 1)
+		return x * pi / 2;
+	return atan_ref(x / sqrt_ref((1 - x) * (1 + x)));
+}
+
+static ld
+acos_ref(ld x)
+{
+	if (x == -1)
+		return pi;
+	return 2 * atan_ref(sqrt_ref((1 - x) / (1 + x)));
+}
+
+static ld
+atan2_ref(ld y, ld x)
+{
+	ld r;
+
+	if (x == 0)
+		return y < 0 ? -pi / 2 : pi / 2;
+	r = atan_ref(y / x);
+	if (x < 0)
+		r += y < 0 ? -pi : pi;
+	return r;
+}
+
+static double
+ulp_error(double got, ld want)
+{
+	double w = (double) want;
+	int e;
+
+	if (isinf(w) || isinf(got))
+		return got == w ? 0 : INFINITY;
+	if (w == 0)
+		return (double) (abs_ref(got - want) / 0x1p-1074L);
+	frexp(w, &e);
+	/* want just below a power of two rounded up to it */
+	if (fabs(w) == ldexp(0.5, e) && abs_ref(want) < fabs(w))
+		e--;
+	return (double) (abs_ref(got - want) / ldexp(1.0, e - 53 < -1074 ? -1074 : e - 53));
+}
+
+static uint64_t seed = 0x5eed;
+
+static double
+uniform(void)
+{
+	seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (double) (seed >> 11) * 0x1p-53;
+}
+
+struct range {
+	double	lo, hi;
+	int	logscale;
+};
+
+static double
+sample(const struct range *r)
+{
+	double u = uniform();
+
+	if (r->logscale)
+		return exp2(log2(r->lo) + (log2(r->hi) - log2(r->lo)) * u);
+	return r->lo + (r->hi - r->lo) * u;
+}
+
+#define LIN(lo, hi)	{ lo, hi, 0 }
+#define LOG(lo, hi)	{ lo, hi, 1 }
+
+static const struct {
+	const char	*name;
+	double		(*f)(double);
+	ld		(*ref)(ld);
+	struct range	r[3];
+} funcs[] = {
+	{ "log10", log10, log10_ref, { LOG(1e-300, 1e300), LIN(0.5, 2) } },
+	{ "log1p", log1p, log1p_ref, { LIN(-0.9, 1), LOG(1e-10, 1e10), LIN(-1e-3, 1e-3) } },
+	{ "expm1", expm1, expm1_ref, { LIN(-1, 1), LIN(-40, 700), LIN(-1e-5, 1e-5) } },
+	{ "sinh", sinh, sinh_ref, { LIN(-1, 1), LIN(-710, 710) } },
+	{ "cosh", cosh, cosh_ref, { LIN(-1, 1), LIN(-710, 710) } },
+	{ "tanh", tanh, tanh_ref, { LIN(-1, 1), LIN(-25, 25), LOG(1e-10, 1e-2) } },
+	{ "asin", asin, asin_ref, { LIN(-1, 1), LIN(0.9, 1) } },
+	{ "acos", acos, acos_ref, { LIN(-1, 1), LIN(0.9, 1), LIN(-1, -0.9) } },
+	{ "atan", atan, atan_ref, { LIN(-2, 2), LOG(1e-10, 1e10) } },
+};
+
+static int
+report(const char *name, double max, double at)
+{
+	printf("%-6s max %.3f ulp at %.17g\n", name, max, at);
+	if (max > MAX_ULP) {
+		printf("%s: error above %.1f ulp\n", name, MAX_ULP);
+		return 1;
+	}
+	return 0;
+}
+
+int
+main(void)
+{
+	static const struct range atan2_r[] = { LIN(-10, 10), LOG(1e-20, 1e20) };
+	int error = 0;
+	unsigned f, r, i;
+
+	for (f = 0; f < sizeof(funcs) / sizeof(funcs[0]); f++) {
+		double max = 0, at = 0;
+
+		for (r = 0; r < 3 && funcs[f].r[r].lo != funcs[f].r[r].hi; r++) {
+			for (i = 0; i < ULP_SWEEP_COUNT; i++) {
+				double x = sample(&funcs[f].r[r]);
+				double err = ulp_error(funcs[f].f(x), funcs[f].ref(x));
+
+				if (err > max) {
+					max = err;
+					at = x;
+				}
+			}
+		}
+		error |= report(funcs[f].name, max, at);
+	}
+
+	{
+		double max = 0, at = 0;
+
+		for (r = 0; r < sizeof(atan2_r) / sizeof(atan2_r[0]); r++) {
+			for (i = 0; i < ULP_SWEEP_COUNT; i++) {
+				double y = sample(&atan2_r[r]);
+				double x = sample(&atan2_r[r]);
+				double err;
+
+				/* the log scale range only yields positive values */
+				if (atan2_r[r].logscale) {
+					if (i & 1)
+						y = -y;
+					if (i & 2)
+						x = -x;
+				}
+				err = ulp_error(atan2(y, x), atan2_ref(y, x));
+				if (err > max) {
+					max = err;
+					at = y / x;
+				}
+			}
+		}
+		error |= report("atan2", max, at);
+	}
+	return error;
+}
+
+#else
+
+int
+main(void)
+{
+	printf("long double is not wider than double, skipping\n");
+	return 77;
+}
+
+#endif
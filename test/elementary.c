@@ -0,0 +1,238 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+/*
+ * Spot checks for log10, log1p, expm1, sinh, cosh, tanh, asin, acos,
+ * atan and atan2: values on each side of the internal breakpoints,
+ * special values and the signed results of atan2 on the axes.
+ */
+
+static int64_t
+ordered(double x)
+{
+	int64_t i;
+
+	memcpy(&i, &x, sizeof(i));
+	return i < 0 ? INT64_MIN - i : i;
+}
+
+static int
+check(const char *name, double x, double got, double want)
+{
+	int64_t d = ordered(got) - ordered(want);
+
+	if (isnan(want) ? !isnan(got) : (d > 1 || d < -1)) {
+		printf("%s(%.17g) = %.17g, want %.17g\n", name, x, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static int
+check_exact(const char *name, double x, double got, double want)
+{
+	if (got != want || signbit(got) != signbit(want)) {
+		printf("%s(%.17g) = %.17g, want %.17g\n", name, x, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static int
+check_errno(const char *name, double x, int got, int want)
+{
+	if ((math_errhandling & MATH_ERRNO) && got != want) {
+		printf("%s(%.17g) errno %d, want %d\n", name, x, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static const struct {
+	double x, log10, log1p, expm1;
+} logs[] = {
+	{ 0.001, -3.0, 0.0009995003330835331, 0.0010005001667083417 },
+	{ 0.5, -0.3010299956639812, 0.4054651081081644, 0.6487212707001282 },
+	{ 1.5, 0.17609125905568124, 0.9162907318741551, 3.481689070338065 },
+	{ 123.0, 2.089905111439398, 4.820281565605037, 2.6195173187490626e+53 },
+};
+
+static const struct {
+	double x, sinh, cosh, tanh;
+} hyps[] = {
+	{ 0.1, 0.10016675001984403, 1.0050041680558035, 0.09966799462495582 },
+	{ 0.6, 0.6366535821482412, 1.1854652182422676, 0.5370495669980353 },
+	{ -2.5, -6.0502044810397875, 6.132289479663686, -0.9866142981514303 },
+	{ 15.0, 1634508.6862359024, 1634508.6862362083, 0.9999999999998128 },
+	{ 700.0, 5.0711602736750225e+303, 5.0711602736750225e+303, 1.0 },
+};
+
+static const struct {
+	double x, asin, acos;
+} asins[] = {
+	{ 0.5, 0.5235987755982989, 1.0471975511965979 },
+	{ 0.75, 0.848062078981481, 0.7227342478134157 },
+	{ -0.3, -0.3046926540153975, 1.8754889808102941 },
+	{ 1e-05, 1.0000000000166668e-05, 1.5707863267948965 },
+	{ 0.999, 1.526071239626163, 0.044725087168733454 },
+};
+
+static const struct {
+	double x, atan;
+} atans[] = {
+	{ 0.1, 0.09966865249116204 },
+	{ 0.5, 0.4636476090008061 },
+	{ 0.9, 0.7328151017865066 },
+	{ 2.0, 1.1071487177940904 },
+	{ -30.0, -1.5374753309166493 },
+	{ 1e10, 1.5707963266948965 },
+};
+
+static const struct {
+	double y, x, atan2;
+} atan2s[] = {
+	{ 1.0, 2.0, 0.4636476090008061 },
+	{ -3.0, -4.0, -2.498091544796509 },
+	{ 0.7, -0.1, 1.7126933813990606 },
+	{ 1e-300, 1e-310, 1.5707963266948965 },
+	{ 1e300, -2e300, 2.677945044588987 },
+	{ 0.0, 1.0, 0.0 },
+	{ -0.0, 1.0, -0.0 },
+	{ 0.0, -0.0, M_PI },
+	{ -0.0, -1.0, -M_PI },
+	{ 1.0, 0.0, M_PI_2 },
+	{ -1.0, -0.0, -M_PI_2 },
+	{ INFINITY, INFINITY, M_PI_4 },
+	{ -INFINITY, -INFINITY, -3 * M_PI_4 },
+	{ 1.0, -INFINITY, M_PI },
+	{ -1.0, INFINITY, -0.0 },
+};
+
+int
+main(void)
+{
+	int error = 0;
+	unsigned i;
+
+	for (i = 0; i < sizeof(logs) / sizeof(logs[0]); i++) {
+		double x = logs[i].x;
+
+		error |= check("log10", x, log10(x), logs[i].log10);
+		error |= check("log1p", x, log1p(x), logs[i].log1p);
+		error |= check("expm1", x, expm1(x), logs[i].expm1);
+	}
+	for (i = 0; i < sizeof(hyps) / sizeof(hyps[0]); i++) {
+		double x = hyps[i].x;
+
+		error |= check("sinh", x, sinh(x), hyps[i].sinh);
+		error |= check("cosh", x, cosh(x), hyps[i].cosh);
+		error |= check("tanh", x, tanh(x), hyps[i].tanh);
+		error |= check("sinh", -x, sinh(-x), -hyps[i].sinh);
+		error |= check("cosh", -x, cosh(-x), hyps[i].cosh);
+	}
+	for (i = 0; i < sizeof(asins) / sizeof(asins[0]); i++) {
+		double x = asins[i].x;
+
+		error |= check("asin", x, asin(x), asins[i].asin);
+		error |= check("acos", x, acos(x), asins[i].acos);
+		error |= check("asin", -x, asin(-x), -asins[i].asin);
+	}
+	for (i = 0; i < sizeof(atans) / sizeof(atans[0]); i++) {
+		double x = atans[i].x;
+
+		error |= check("atan", x, atan(x), atans[i].atan);
+		error |= check("atan", -x, atan(-x), -atans[i].atan);
+	}
+	for (i = 0; i < sizeof(atan2s) / sizeof(atan2s[0]); i++) {
+		double y = atan2s[i].y;
+
+		if (atan2s[i].atan2 == 0)
+			error |= check_exact("atan2", y, atan2(y, atan2s[i].x), atan2s[i].atan2);
+		else
+			error |= check("atan2", y, atan2(y, atan2s[i].x), atan2s[i].atan2);
+	}
+
+	/* Signed zeros and the ends of the ranges */
+	error |= check_exact("log10", 1.0, log10(1.0), 0.0);
+	error |= check_exact("log1p", -0.0, log1p(-0.0), -0.0);
+	error |= check_exact("expm1", -0.0, expm1(-0.0), -0.0);
+	error |= check_exact("expm1", -INFINITY, expm1(-INFINITY), -1.0);
+	error |= check_exact("sinh", -0.0, sinh(-0.0), -0.0);
+	error |= check_exact("cosh", -0.0, cosh(-0.0), 1.0);
+	error |= check_exact("tanh", -0.0, tanh(-0.0), -0.0);
+	error |= check_exact("tanh", -INFINITY, tanh(-INFINITY), -1.0);
+	error |= check_exact("asin", -0.0, asin(-0.0), -0.0);
+	error |= check_exact("acos", 1.0, acos(1.0), 0.0);
+	error |= check("acos", -1.0, acos(-1.0), M_PI);
+	error |= check("asin", -1.0, asin(-1.0), -M_PI_2);
+	error |= check_exact("atan", -0.0, atan(-0.0), -0.0);
+	error |= check("atan", INFINITY, atan(INFINITY), M_PI_2);
+	error |= check_exact("sinh", 0x1p-1030, sinh(0x1p-1030), 0x1p-1030);
+	error |= check_exact("atan", 0x1p-1030, atan(0x1p-1030), 0x1p-1030);
+
+	/* Domain and range errors */
+	errno = 0;
+	error |= check("asin", 2.0, asin(2.0), NAN);
+	error |= check_errno("asin", 2.0, errno, EDOM);
+	errno = 0;
+	error |= check("acos", -1.5, acos(-1.5), NAN);
+	error |= check_errno("acos", -1.5, errno, EDOM);
+	errno = 0;
+	error |= check("log1p", -2.0, log1p(-2.0), NAN);
+	error |= check_errno("log1p", -2.0, errno, EDOM);
+	errno = 0;
+	error |= check_exact("log1p", -1.0, log1p(-1.0), -INFINITY);
+	error |= check_errno("log1p", -1.0, errno, ERANGE);
+	errno = 0;
+	error |= check_exact("log10", 0.0, log10(0.0), -INFINITY);
+	error |= check_errno("log10", 0.0, errno, ERANGE);
+	errno = 0;
+	error |= check_exact("sinh", -800.0, sinh(-800.0), -INFINITY);
+	error |= check_errno("sinh", -800.0, errno, ERANGE);
+	errno = 0;
+	error |= check_exact("cosh", 800.0, cosh(800.0), INFINITY);
+	error |= check_errno("cosh", 800.0, errno, ERANGE);
+	errno = 0;
+	error |= check_exact("expm1", 800.0, expm1(800.0), INFINITY);
+	error |= check_errno("expm1", 800.0, errno, ERANGE);
+	return error;
+}
@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+
+static char buf[256];
+
+int
+main(void)
+{
+	struct mallarena arena;
+	struct mallarena_mark mark;
+	int result = 0;
+	char *a, *b, *c;
+	int i;
+
+	/* Fixed buffer, no growth */
+	mallarena_init(&arena, buf, sizeof(buf), 0);
+
+	a = mallarena_alloc(&arena, 10);
+	b = mallarena_alloc(&arena, 10);
+	if (!a || !b || b < a + 10) {
+		printf("allocations overlap %p %p\n", a, b);
+		result++;
+	}
+	c = mallarena_alloc_aligned(&arena, 1, 64);
+	if (!c || ((uintptr_t) c & 63)) {
+		printf("aligned allocation %p not aligned\n", c);
+		result++;
+	}
+
+	mark = mallarena_mark(&arena);
+	b = mallarena_alloc(&arena, 100);
+	if (b == NULL) {
+		printf("allocation after mark failed\n");
+		result++;
+	}
+	mallarena_release(&arena, mark);
+	if (mallarena_alloc(&arena, 100) != b) {
+		printf("release did not return space\n");
+		result++;
+	}
+
+	errno = 0;
+	if (mallarena_alloc(&arena, sizeof(buf)) != NULL || errno != ENOMEM) {
+		printf("oversized allocation succeeded\n");
+		result++;
+	}
+
+	mallarena_reset(&arena);
+	if (mallarena_alloc(&arena, 10) != a) {
+		printf("reset did not rewind arena\n");
+		result++;
+	}
+	mallarena_destroy(&arena);
+
+	/* Growing arena */
+	mallarena_init(&arena, NULL, 64, 128);
+	a = mallarena_alloc(&arena, 32);
+	mark = mallarena_mark(&arena);
+	for (i = 0; i < 100; i++) {
+		b = mallarena_alloc(&arena, 48);
+		if (!b) {
+			printf("growing allocation %d failed\n", i);
+			result++;
+			break;
+		}
+		memset(b, i, 48);
+	}
+	b = mallarena_alloc(&arena, 1000);
+	if (!b) {
+		printf("large allocation failed\n");
+		result++;
+	}
+	mallarena_release(&arena, mark);
+	if (mallarena_alloc(&arena, 32) != a + 32) {
+		printf("release across blocks failed\n");
+		result++;
+	}
+	mallarena_destroy(&arena);
+
+	return result;
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+
+struct obj {
+	int	id;
+	char	name[13];
+};
+
+#define NOBJ	10
+
+static struct obj objs[NOBJ];
+
+static int
+check_pool(struct mallpool *pool, const char *which)
+{
+	struct obj *got[NOBJ];
+	struct mallinfo info;
+	int result = 0;
+	int i, j;
+
+	for (i = 0; i < NOBJ; i++) {
+		got[i] = mallpool_alloc(pool);
+		if (!got[i]) {
+			printf("%s: alloc %d failed\n", which, i);
+			return 1;
+		}
+		for (j = 0; j < i; j++)
+			if (got[j] == got[i]) {
+				printf("%s: object %d returned twice\n", which, i);
+				result++;
+			}
+		got[i]->id = i;
+		memset(got[i]->name, 'a' + i, sizeof(got[i]->name));
+	}
+
+	errno = 0;
+	if (mallpool_alloc(pool) != NULL || errno != ENOMEM) {
+		printf("%s: alloc from empty pool succeeded\n", which);
+		result++;
+	}
+
+	info = mallpool_info(pool);
+	if (info.ordblks != 0 || info.uordblks != info.arena) {
+		printf("%s: full pool reports %zu free\n", which, info.ordblks);
+		result++;
+	}
+
+	for (i = 0; i < NOBJ; i++) {
+		if (got[i]->id != i || got[i]->name[12] != 'a' + i) {
+			printf("%s: object %d overwritten\n", which, i);
+			result++;
+		}
+	}
+
+	/* Free in a different order and make sure objects come back LIFO */
+	for (i = 0; i < NOBJ; i += 2)
+		mallpool_free(pool, got[i]);
+	if (mallpool_alloc(pool) != got[NOBJ - 2]) {
+		printf("%s: pool is not LIFO\n", which);
+		result++;
+	}
+	mallpool_free(pool, got[NOBJ - 2]);
+	for (i = 1; i < NOBJ; i += 2)
+		mallpool_free(pool, got[i]);
+
+	errno = 0;
+	mallpool_free(pool, (char *) got[0] + 1);
+	if (errno != EINVAL) {
+		printf("%s: free of bad pointer accepted\n", which);
+		result++;
+	}
+
+	info = mallpool_info(pool);
+	if (info.ordblks != NOBJ || info.uordblks != 0 || info.usmblks != info.arena) {
+		printf("%s: empty pool reports %zu free %zu in use %zu max\n",
+		       which, info.ordblks, info.uordblks, info.usmblks);
+		result++;
+	}
+	return result;
+}
+
+int
+main(void)
+{
+	struct mallpool pool;
+	int result = 0;
+
+	if (mallpool_init(&pool, sizeof(struct obj), NOBJ, objs, 0) != 0) {
+		printf("static pool init failed\n");
+		return 1;
+	}
+	result += check_pool(&pool, "static");
+	mallpool_destroy(&pool);
+
+	if (mallpool_init(&pool, sizeof(struct obj), NOBJ, NULL, MALLPOOL_ATOMIC) != 0) {
+		printf("allocated pool init failed\n");
+		return 1;
+	}
+	result += check_pool(&pool, "atomic");
+	mallpool_destroy(&pool);
+
+	if (mallpool_init(&pool, sizeof(struct obj), 0, NULL, 0) == 0) {
+		printf("empty pool init succeeded\n");
+		result++;
+	}
+
+	return result;
+}
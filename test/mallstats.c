@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <malloc.h>
+
+static void *last_alloc, *last_free;
+static size_t last_alloc_size;
+static int nalloc_hook, nfree_hook;
+
+static void
+alloc_hook(void *ptr, size_t size, void *caller)
+{
+	(void) caller;
+	last_alloc = ptr;
+	last_alloc_size = size;
+	nalloc_hook++;
+}
+
+static void
+free_hook(void *ptr, size_t size, void *caller)
+{
+	(void) size;
+	(void) caller;
+	last_free = ptr;
+	nfree_hook++;
+}
+
+#define check(cond) do {						\
+		if (!(cond)) {						\
+			printf("%s:%d: %s failed\n", __FILE__, __LINE__, #cond); \
+			result++;					\
+		}							\
+	} while (0)
+
+static size_t
+count_total(struct mallstats *s)
+{
+	size_t total = 0;
+	size_t c;
+
+	for (c = 0; c < MALLSTATS_CLASSES; c++)
+		total += s->count[c];
+	return total;
+}
+
+int
+main(void)
+{
+	struct mallstats before, s;
+	int result = 0;
+	void *p[16];
+	void *big;
+	int i;
+
+	mallstats(&before);
+
+	for (i = 0; i < 16; i++)
+		p[i] = malloc(16 + i * 8);
+	mallstats(&s);
+	check(s.in_use > before.in_use + 16 * 16);
+	check(count_total(&s) == count_total(&before) + 16);
+	check(s.max_in_use >= s.in_use);
+	check(s.sbrk_calls > 0);
+	check(s.arena >= s.in_use);
+
+	for (i = 0; i < 16; i++)
+		free(p[i]);
+	mallstats(&s);
+	check(s.in_use == before.in_use);
+	check(count_total(&s) == count_total(&before));
+	check(s.max_in_use > s.in_use);
+
+	/* realloc and memalign keep the totals balanced */
+	big = malloc(10);
+	big = realloc(big, 1000);
+	big = realloc(big, 20);
+	free(big);
+	big = memalign(256, 100);
+	check(((uintptr_t) big & 255) == 0);
+	free(big);
+	big = calloc(10, 10);
+	free(big);
+	mallstats(&s);
+	check(s.in_use == before.in_use);
+	check(count_total(&s) == count_total(&before));
+
+	/* a freed large block lands in the free pool */
+	big = malloc(4000);
+	free(big);
+	mallstats(&s);
+	check(s.largest_free >= 4000);
+	check(s.largest_free <= s.arena);
+
+	/* failed allocations are counted */
+	errno = 0;
+	big = malloc(SIZE_MAX / 2);
+	check(big == NULL);
+	mallstats(&s);
+	check(s.failed == before.failed + 1);
+
+	/* the hooks see each allocation and free */
+	mallstats_set_hooks(alloc_hook, free_hook);
+	big = malloc(42);
+	check(nalloc_hook == 1 && last_alloc == big && last_alloc_size == 42);
+	free(big);
+	check(nfree_hook == 1 && last_free == big);
+	mallstats_set_hooks(NULL, NULL);
+	big = malloc(42);
+	free(big);
+	check(nalloc_hook == 1 && nfree_hook == 1);
+
+	return result;
+}
@@ -0,0 +1,432 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Measure the speed of the double and float libm functions.  Each
+ * function runs over four input classes: tiny arguments, its normal
+ * working range, huge arguments and special values (zeros,
+ * infinities, NaN and subnormals).  For each class two numbers are
+ * reported:
+ *
+ *	ns_per_call	independent calls, the throughput a loop over
+ *			an array would see
+ *	latency_ns	each argument depends on the previous result, the
+ *			time a chain of dependent calls would see
+ *
+ * The output is CSV so that runs can be compared by a script.
+ * Arguments, if any, select the functions to run by name; "-t n" makes
+ * each measurement last n clock ticks rather than one.  One tick keeps
+ * the run short, numbers worth comparing need more.  This is a meson
+ * benchmark, run by 'meson test --benchmark' rather than with the
+ * tests.
+ *
+ * Functions taking integer or pointer arguments and the long double
+ * functions are not measured.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+
+#define NARG		256
+
+enum kind { d_d, d_dd, f_f, f_ff };
+
+/* Arguments are only taken from the positive half of tiny and huge */
+#define POS	1
+
+struct func {
+	const char	*name;
+	enum kind	kind;
+	union {
+		double	(*d_d)(double);
+		double	(*d_dd)(double, double);
+		float	(*f_f)(float);
+		float	(*f_ff)(float, float);
+	} f;
+	double		lo, hi;		/* normal range of x */
+	double		ylo, yhi;	/* range of y for two argument functions */
+	double		hlo, hhi;	/* magnitude of huge x */
+	int		flags;
+};
+
+#define F1(fn, lo, hi, hlo, hhi, flags)					\
+	{ #fn, d_d, { .d_d = fn }, lo, hi, 0, 0, hlo, hhi, flags },	\
+	{ #fn "f", f_f, { .f_f = fn ## f }, lo, hi, 0, 0, hlo, hhi, flags }
+
+#define F2(fn, lo, hi, ylo, yhi, hlo, hhi, flags)			\
+	{ #fn, d_dd, { .d_dd = fn }, lo, hi, ylo, yhi, hlo, hhi, flags }, \
+	{ #fn "f", f_ff, { .f_ff = fn ## f }, lo, hi, ylo, yhi, hlo, hhi, flags }
+
+/*
+ * Huge ranges stay below FLT_MAX so the float functions see the same
+ * class of argument; where a function overflows or goes out of its
+ * domain that path is what gets measured.
+ */
+static const struct func funcs[] = {
+	F1(acos,	-1,	1,	2,	1e38,	0),
+	F1(acosh,	1,	100,	1e10,	1e38,	POS),
+	F1(asin,	-1,	1,	2,	1e38,	0),
+	F1(asinh,	-10,	10,	1e10,	1e38,	0),
+	F1(atan,	-10,	10,	1e10,	1e38,	0),
+	F1(atanh,	-1,	1,	2,	1e38,	0),
+	F1(cbrt,	-100,	100,	1e10,	1e38,	0),
+	F1(ceil,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(cos,		-10,	10,	1e6,	1e38,	0),
+	F1(cosh,	-20,	20,	800,	1e38,	0),
+	F1(erf,		-5,	5,	10,	1e38,	0),
+	F1(erfc,	-5,	25,	30,	1e38,	0),
+	F1(exp,		-20,	20,	800,	1e38,	0),
+	F1(exp10,	-15,	15,	400,	1e38,	0),
+	F1(exp2,	-50,	50,	1100,	1e38,	0),
+	F1(expm1,	-5,	5,	800,	1e38,	0),
+	F1(fabs,	-100,	100,	1e10,	1e38,	0),
+	F1(floor,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(j0,		-20,	20,	1e10,	1e38,	0),
+	F1(j1,		-20,	20,	1e10,	1e38,	0),
+	F1(lgamma,	-10,	20,	1e10,	1e38,	0),
+	F1(log,		0.01,	100,	1e10,	1e38,	POS),
+	F1(log10,	0.01,	100,	1e10,	1e38,	POS),
+	F1(log1p,	-0.5,	10,	1e10,	1e38,	POS),
+	F1(log2,	0.01,	100,	1e10,	1e38,	POS),
+	F1(logb,	-100,	100,	1e10,	1e38,	0),
+	F1(nearbyint,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(rint,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(round,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(sin,		-10,	10,	1e6,	1e38,	0),
+	F1(sinh,	-20,	20,	800,	1e38,	0),
+	F1(sqrt,	0,	100,	1e10,	1e38,	POS),
+	F1(tan,		-10,	10,	1e6,	1e38,	0),
+	F1(tanh,	-5,	5,	30,	1e38,	0),
+	F1(tgamma,	0.5,	20,	200,	1e38,	POS),
+	F1(trunc,	-1e6,	1e6,	1e16,	1e38,	0),
+	F1(y0,		0.1,	20,	1e10,	1e38,	POS),
+	F1(y1,		0.1,	20,	1e10,	1e38,	POS),
+	F2(atan2,	-10,	10,	-10,	10,	1e10,	1e38,	0),
+	F2(copysign,	-100,	100,	-100,	100,	1e10,	1e38,	0),
+	F2(fdim,	-100,	100,	-100,	100,	1e10,	1e38,	0),
+	F2(fmax,	-100,	100,	-100,	100,	1e10,	1e38,	0),
+	F2(fmin,	-100,	100,	-100,	100,	1e10,	1e38,	0),
+	F2(fmod,	-1e6,	1e6,	0.5,	100,	1e10,	1e38,	0),
+	F2(hypot,	-1e3,	1e3,	-1e3,	1e3,	1e10,	1e38,	0),
+	F2(nextafter,	-100,	100,	-100,	100,	1e10,	1e38,	0),
+	F2(pow,		0.1,	10,	-20,	20,	1e10,	1e38,	POS),
+	F2(remainder,	-1e6,	1e6,	0.5,	100,	1e10,	1e38,	0),
+};
+
+#define NFUNC	(sizeof(funcs) / sizeof(funcs[0]))
+
+enum range { tiny, normal, huge, special };
+
+static const char *const range_names[] = { "tiny", "normal", "huge", "special" };
+
+static double	dx[NARG + 1], dy[NARG], dout[NARG];
+static float	fx[NARG + 1], fy[NARG], fout[NARG];
+
+/* All zeros, but the compiler cannot know that */
+static volatile uint64_t zero_bits;
+
+volatile double	sink;
+
+static uint64_t	rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t
+rand64(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 7;
+	rand_state ^= rand_state << 17;
+	return rand_state;
+}
+
+/* uniform in [lo, hi) */
+static double
+uniform(double lo, double hi)
+{
+	return lo + (hi - lo) * ((double) (rand64() >> 11) * 0x1p-53);
+}
+
+/* magnitude uniform in the exponent between lo and hi */
+static double
+log_uniform(double lo, double hi, int flags)
+{
+	double	x = exp2(uniform(log2(lo), log2(hi)));
+
+	if (!(flags & POS) && (rand64() & 1))
+		x = -x;
+	return x;
+}
+
+static double
+special_value(unsigned i, int is_float)
+{
+	static const double values[] = { 0.0, -0.0, INFINITY, -INFINITY, NAN, 1.0, -1.0, 0.0 };
+	unsigned	v = i % (sizeof(values) / sizeof(values[0]));
+
+	/* the last entry is the smallest subnormal of the type */
+	if (v == sizeof(values) / sizeof(values[0]) - 1)
+		return is_float ? 0x1p-149 : 0x1p-1074;
+	return values[v];
+}
+
+static void
+fill(const struct func *f, enum range r)
+{
+	int	is_float = f->kind == f_f || f->kind == f_ff;
+	unsigned i;
+
+	for (i = 0; i <= NARG; i++) {
+		double x, y;
+
+		switch (r) {
+		case tiny:
+			x = log_uniform(0x1p-60, 0x1p-27, f->flags);
+			break;
+		case normal:
+		default:
+			x = uniform(f->lo, f->hi);
+			break;
+		case huge:
+			x = log_uniform(f->hlo, f->hhi, f->flags);
+			break;
+		case special:
+			x = special_value(i, is_float);
+			break;
+		}
+		y = uniform(f->ylo, f->yhi);
+		dx[i] = x;
+		fx[i] = (float) x;
+		if (i < NARG) {
+			dy[i] = y;
+			fy[i] = (float) y;
+		}
+	}
+}
+
+/*
+ * The next argument is the table value with the bits of the result
+ * masked off by zero_bits, which puts the call on the critical path
+ * without changing the argument.
+ */
+static double
+chain(double x, double y, uint64_t zero)
+{
+	uint64_t	ux, uy;
+
+	memcpy(&ux, &x, sizeof(ux));
+	memcpy(&uy, &y, sizeof(uy));
+	ux |= uy & zero;
+	memcpy(&x, &ux, sizeof(x));
+	return x;
+}
+
+static float
+chainf(float x, float y, uint32_t zero)
+{
+	uint32_t	ux, uy;
+
+	memcpy(&ux, &x, sizeof(ux));
+	memcpy(&uy, &y, sizeof(uy));
+	ux |= uy & zero;
+	memcpy(&x, &ux, sizeof(x));
+	return x;
+}
+
+static void
+run(const struct func *f, int latency)
+{
+	uint64_t	zero = zero_bits;
+	unsigned	i;
+
+	switch (f->kind) {
+	case d_d:
+		if (latency) {
+			double x = dx[0];
+			for (i = 0; i < NARG; i++)
+				x = chain(dx[i + 1], f->f.d_d(x), zero);
+			sink = x;
+		} else {
+			for (i = 0; i < NARG; i++)
+				dout[i] = f->f.d_d(dx[i]);
+			sink = dout[NARG - 1];
+		}
+		break;
+	case d_dd:
+		if (latency) {
+			double x = dx[0];
+			for (i = 0; i < NARG; i++)
+				x = chain(dx[i + 1], f->f.d_dd(x, dy[i]), zero);
+			sink = x;
+		} else {
+			for (i = 0; i < NARG; i++)
+				dout[i] = f->f.d_dd(dx[i], dy[i]);
+			sink = dout[NARG - 1];
+		}
+		break;
+	case f_f:
+		if (latency) {
+			float x = fx[0];
+			for (i = 0; i < NARG; i++)
+				x = chainf(fx[i + 1], f->f.f_f(x), (uint32_t) zero);
+			sink = x;
+		} else {
+			for (i = 0; i < NARG; i++)
+				fout[i] = f->f.f_f(fx[i]);
+			sink = fout[NARG - 1];
+		}
+		break;
+	case f_ff:
+		if (latency) {
+			float x = fx[0];
+			for (i = 0; i < NARG; i++)
+				x = chainf(fx[i + 1], f->f.f_ff(x, fy[i]), (uint32_t) zero);
+			sink = x;
+		} else {
+			for (i = 0; i < NARG; i++)
+				fout[i] = f->f.f_ff(fx[i], fy[i]);
+			sink = fout[NARG - 1];
+		}
+		break;
+	}
+}
+
+/* Length of a measurement in clock units */
+static clock_t	min_time;
+
+/*
+ * Wait for the clock to change and return the new value, or -1 if it
+ * does not.  Many targets only have a coarse clock, so measurements
+ * start and stop on a tick rather than somewhere between two.
+ */
+static clock_t
+next_tick(void)
+{
+	clock_t		c = clock(), n;
+	unsigned long	spin;
+
+	for (spin = 0; spin < 1000000; spin++) {
+		n = clock();
+		if (n != c)
+			return n;
+	}
+	return (clock_t) -1;
+}
+
+/*
+ * Time passes over the arguments from the clock tick at *START until
+ * min_time has gone by, which is at most one pass over.  *START is
+ * left at the tick where the measurement stopped, so the next one can
+ * begin there.  Returns hundredths of a nanosecond per call.
+ */
+static long
+measure(const struct func *f, int latency, clock_t *start)
+{
+	unsigned long	passes = 0;
+	clock_t		t;
+
+	do {
+		run(f, latency);
+		passes++;
+		t = clock() - *start;
+	} while (t < min_time);
+	*start += t;
+	return (long) ((double) t * (1e11 / CLOCKS_PER_SEC) / ((double) passes * NARG) + 0.5);
+}
+
+static void
+print_ns(long v)
+{
+	printf("%ld.%02ld", v / 100, v % 100);
+}
+
+static int
+selected(const char *name, int argc, char **argv)
+{
+	int	i;
+
+	if (argc < 2)
+		return 1;
+	for (i = 1; i < argc; i++)
+		if (!strcmp(argv[i], name))
+			return 1;
+	return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+	unsigned	i;
+	int		r;
+	long		ticks = 1;
+	clock_t		tick, start;
+
+	if (argc > 2 && !strcmp(argv[1], "-t")) {
+		ticks = atol(argv[2]);
+		argc -= 2;
+		argv += 2;
+	}
+	tick = next_tick();
+	if (tick == (clock_t) -1 || (tick = next_tick() - tick) <= 0) {
+		printf("no clock available\n");
+		return 0;
+	}
+	min_time = tick * (ticks > 0 ? ticks : 1);
+
+	printf("function,range,ns_per_call,latency_ns\n");
+	for (i = 0; i < NFUNC; i++) {
+		const struct func *f = &funcs[i];
+
+		if (!selected(f->name, argc, argv))
+			continue;
+		for (r = tiny; r <= special; r++) {
+			long	thr, lat;
+
+			fill(f, (enum range) r);
+			/* Leave filling and printing out of the measurement */
+			start = next_tick();
+			thr = measure(f, 0, &start);
+			lat = measure(f, 1, &start);
+			printf("%s,%s,", f->name, range_names[r]);
+			print_ns(thr);
+			printf(",");
+			print_ns(lat);
+			printf("\n");
+		}
+	}
+	return 0;
+}
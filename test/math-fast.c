@@ -0,0 +1,243 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <float.h>
+#include <fenv.h>
+#include <math.h>
+
+/*
+ * Check that the __fast_ entry points return exactly what the regular
+ * functions do, leave errno alone and still raise the exception
+ * flags for overflow, division by zero and invalid operands.
+ */
+
+static const double dspecial[] = {
+	0.0, -0.0, 1.0, -1.0, 2.0, 0.5, 0.99, 1.01, 0x1.921fb54442d18p+0,
+	0x1p-1074, -0x1p-1074, 0x1p-1022, 0x1p-30, -0x1p-60, DBL_MAX, -DBL_MAX,
+	INFINITY, -INFINITY, NAN, 88.0, -104.0, 700.0, -750.0, 710.0,
+	1e6, 0x1p20, 3e20, 1e300,
+};
+
+#define NSPECIAL (sizeof(dspecial) / sizeof(dspecial[0]))
+#define NRANDOM	200
+
+static uint32_t seed = 1;
+
+static uint32_t
+rnd(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+/* Random value of either sign with exponent in [lo, hi) */
+static double
+rnd_val(int lo, int hi)
+{
+	double v = ldexp(1.0 + (rnd() & 0xffff) / 65536.0, lo + (int) (rnd() % (hi - lo)));
+
+	return (rnd() & 1) ? -v : v;
+}
+
+static double
+arg(int i)
+{
+	return i < (int) NSPECIAL ? dspecial[i] : rnd_val(-30, 12);
+}
+
+static int
+same(double got, double want)
+{
+	if (isnan(want))
+		return isnan(got);
+	return memcmp(&got, &want, sizeof(got)) == 0;
+}
+
+static int
+samef(float got, float want)
+{
+	if (isnan(want))
+		return isnan(got);
+	return memcmp(&got, &want, sizeof(got)) == 0;
+}
+
+static const struct {
+	const char *name;
+	double (*fast)(double);
+	double (*f)(double);
+} dfuncs[] = {
+	{ "exp", __fast_exp, exp },
+	{ "exp2", __fast_exp2, exp2 },
+	{ "log", __fast_log, log },
+	{ "log2", __fast_log2, (log2) },
+	{ "log10", __fast_log10, log10 },
+	{ "log1p", __fast_log1p, log1p },
+	{ "expm1", __fast_expm1, expm1 },
+	{ "sin", __fast_sin, sin },
+	{ "cos", __fast_cos, cos },
+	{ "tan", __fast_tan, tan },
+	{ "sinh", __fast_sinh, sinh },
+	{ "cosh", __fast_cosh, cosh },
+	{ "tanh", __fast_tanh, tanh },
+	{ "asin", __fast_asin, asin },
+	{ "acos", __fast_acos, acos },
+	{ "atan", __fast_atan, atan },
+};
+
+static const struct {
+	const char *name;
+	float (*fast)(float);
+	float (*f)(float);
+} ffuncs[] = {
+	{ "expf", __fast_expf, expf },
+	{ "exp2f", __fast_exp2f, exp2f },
+	{ "logf", __fast_logf, logf },
+	{ "log2f", __fast_log2f, log2f },
+	{ "sinf", __fast_sinf, sinf },
+	{ "cosf", __fast_cosf, cosf },
+};
+
+static int
+check_values(void)
+{
+	unsigned i;
+	int j, error = 0;
+
+	for (i = 0; i < sizeof(dfuncs) / sizeof(dfuncs[0]); i++) {
+		for (j = 0; j < (int) NSPECIAL + NRANDOM; j++) {
+			double x = arg(j), got, want;
+
+			errno = 0;
+			got = dfuncs[i].fast(x);
+			if (errno != 0) {
+				printf("__fast_%s(%.17g) set errno %d\n", dfuncs[i].name, x, errno);
+				error = 1;
+			}
+			want = dfuncs[i].f(x);
+			if (!same(got, want)) {
+				printf("__fast_%s(%.17g) = %.17g, want %.17g\n", dfuncs[i].name, x, got, want);
+				error = 1;
+			}
+		}
+	}
+	for (i = 0; i < sizeof(ffuncs) / sizeof(ffuncs[0]); i++) {
+		for (j = 0; j < (int) NSPECIAL + NRANDOM; j++) {
+			float x = (float) arg(j), got, want;
+
+			errno = 0;
+			got = ffuncs[i].fast(x);
+			if (errno != 0) {
+				printf("__fast_%s(%.9g) set errno %d\n", ffuncs[i].name, (double) x, errno);
+				error = 1;
+			}
+			want = ffuncs[i].f(x);
+			if (!samef(got, want)) {
+				printf("__fast_%s(%.9g) = %.9g, want %.9g\n", ffuncs[i].name,
+				       (double) x, (double) got, (double) want);
+				error = 1;
+			}
+		}
+	}
+	for (j = 0; j < (int) NSPECIAL + NRANDOM; j++) {
+		double x = arg(j), y = arg((j * 7) % ((int) NSPECIAL + NRANDOM));
+		float fx = (float) x, fy = (float) y;
+
+		errno = 0;
+		if (!same(__fast_pow(x, y), pow(x, y)) ||
+		    !same(__fast_atan2(y, x), atan2(y, x)) ||
+		    !samef(__fast_powf(fx, fy), powf(fx, fy))) {
+			printf("pow/atan2/powf(%.17g, %.17g) differ\n", x, y);
+			error = 1;
+		}
+		errno = 0;
+		(void) __fast_pow(x, y);
+		(void) __fast_atan2(y, x);
+		(void) __fast_powf(fx, fy);
+		if (errno != 0) {
+			printf("__fast_pow(%.17g, %.17g) set errno %d\n", x, y, errno);
+			error = 1;
+		}
+	}
+	return error;
+}
+
+static volatile double big = 1000.0, zero = 0.0, two = 2.0;
+
+static int
+check_flags(void)
+{
+	int error = 0;
+
+#ifdef FE_OVERFLOW
+	feclearexcept(FE_ALL_EXCEPT);
+	(void) __fast_exp(big);
+	if (!fetestexcept(FE_OVERFLOW)) {
+		printf("__fast_exp(%g) did not raise overflow\n", big);
+		error = 1;
+	}
+#endif
+#ifdef FE_DIVBYZERO
+	feclearexcept(FE_ALL_EXCEPT);
+	(void) __fast_log(zero);
+	if (!fetestexcept(FE_DIVBYZERO)) {
+		printf("__fast_log(%g) did not raise divide by zero\n", zero);
+		error = 1;
+	}
+#endif
+#ifdef FE_INVALID
+	feclearexcept(FE_ALL_EXCEPT);
+	(void) __fast_asin(two);
+	if (!fetestexcept(FE_INVALID)) {
+		printf("__fast_asin(%g) did not raise invalid\n", two);
+		error = 1;
+	}
+#endif
+	return error;
+}
+
+int
+main(void)
+{
+	int error = 0;
+
+	error |= check_values();
+	error |= check_flags();
+	return error;
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Measure memcpy, memmove and memset throughput at sizes which land
+ * in each of the size tiers of the optimized implementations: small
+ * overlapping moves, short vector sequences, the vector loop, rep
+ * movsb and non-temporal stores. Each size is repeated until the
+ * run lasts long enough to measure. This is registered as a meson
+ * benchmark, so it only runs under 'meson test --benchmark'; build
+ * with a larger MEMCPY_BENCH_MAX to time copies beyond the last level
+ * cache.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifndef MEMCPY_BENCH_MAX
+#define MEMCPY_BENCH_MAX	(1024UL * 1024)
+#endif
+
+#define MAX_SIZE	MEMCPY_BENCH_MAX
+#define MIN_TIME	(CLOCKS_PER_SEC / 50)
+
+static void *(*volatile do_memcpy)(void *, const void *, size_t) = memcpy;
+static void *(*volatile do_memmove)(void *, const void *, size_t) = memmove;
+static void *(*volatile do_memset)(void *, int, size_t) = memset;
+
+static unsigned char *src, *dst;
+
+enum op { op_memcpy, op_memmove, op_memset };
+
+static const char *const op_names[] = { "memcpy", "memmove", "memset" };
+
+static clock_t
+run(enum op op, size_t size, size_t reps)
+{
+	size_t	r;
+	clock_t	start = clock();
+
+	for (r = 0; r < reps; r++) {
+		switch (op) {
+		case op_memcpy:
+			do_memcpy(dst, src + (r & 7), size);
+			break;
+		case op_memmove:
+			/* overlapping, so it has to copy backwards */
+			do_memmove(src + 8 + (r & 7), src, size);
+			break;
+		case op_memset:
+			do_memset(dst + (r & 7), (int) r, size);
+			break;
+		}
+	}
+	return clock() - start;
+}
+
+int
+main(void)
+{
+	static const size_t sizes[] = {
+		8, 24, 100, 500, 4096, 64 * 1024, 256 * 1024, MAX_SIZE
+	};
+	unsigned	s;
+	int		o;
+	size_t		reps = 0;
+	int		result = 0;
+
+	src = malloc(MAX_SIZE + 16);
+	dst = malloc(MAX_SIZE + 16);
+	if (!src || !dst) {
+		/* not enough memory on this target, skip */
+		printf("malloc failed\n");
+		return 77;
+	}
+	memset(src, 0x5a, MAX_SIZE + 16);
+	memset(dst, 0xa5, MAX_SIZE + 16);
+
+	for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		for (o = op_memcpy; o <= op_memset; o++) {
+			clock_t t;
+
+			reps = 1;
+			for (;;) {
+				t = run((enum op) o, sizes[s], reps);
+				if (t == (clock_t) -1) {
+					printf("no clock available\n");
+					return result;
+				}
+				if (t >= MIN_TIME || reps > SIZE_MAX / 2)
+					break;
+				reps *= 2;
+			}
+			if (t == 0)
+				t = 1;
+			printf("%-8s %8zu bytes: %8lu MB/s\n",
+			       op_names[o], sizes[s],
+			       (unsigned long) ((double) reps * (double) sizes[s] /
+						(1024.0 * 1024.0) *
+						(double) CLOCKS_PER_SEC / (double) t));
+		}
+	}
+
+	/* make sure the copies did something */
+	if (dst[8] != (unsigned char) ((reps - 1) & 0xff)) {
+		printf("memset result wrong %02x\n", dst[8]);
+		result = 1;
+	}
+	free(src);
+	free(dst);
+	return result;
+}
@@ -40,6 +40,10 @@
 
 static const char file_name[] = "posix-io-test-file";
 static const char test_string[] = "hello, world\n";
+static char block[BUFSIZ * 3 + 17];
+static char check[sizeof(block) + 1];
+static char small_buf[37];
+static const long offsets[] = { 10, 3, BUFSIZ * 2 + 5, BUFSIZ * 2 + 1, 0, BUFSIZ - 1 };
 
 static void test_cleanup(void)
 {
@@ -52,6 +56,7 @@ main(int argc, char **argv)
 	FILE		*f;
 	const char	*t;
 	int		c;
+	size_t		i;
 
 	atexit(test_cleanup);
 	f = fopen(file_name, "w");
@@ -85,6 +90,94 @@ main(int argc, char **argv)
 		}
 		t++;
 	}
+	fclose(f);
+
+	/* Block transfers larger than the stdio buffer */
+	for (i = 0; i < sizeof(block); i++)
+		block[i] = (char) (i * 7);
+
+	f = fopen(file_name, "w");
+	if (!f) {
+		printf("failed to open \"%s\" for writing\n", file_name);
+		exit(1);
+	}
+	if (setvbuf(f, NULL, _IOFBF, sizeof(block) * 2) != 0) {
+		printf("setvbuf failed\n");
+		exit(1);
+	}
+	for (i = 0; i < 3; i++) {
+		if (fwrite(block + i, 1, 1, f) != 1) {
+			printf("fwrite of 1 byte failed\n");
+			exit(1);
+		}
+	}
+	if (fwrite(block + 3, 1, sizeof(block) - 3, f) != sizeof(block) - 3) {
+		printf("fwrite of %u bytes failed\n", (unsigned) sizeof(block));
+		exit(1);
+	}
+	fclose(f);
+
+	f = fopen(file_name, "r");
+	if (!f) {
+		printf("failed to open \"%s\" for reading\n", file_name);
+		exit(1);
+	}
+	if (setvbuf(f, small_buf, _IOFBF, sizeof(small_buf)) != 0) {
+		printf("setvbuf failed\n");
+		exit(1);
+	}
+	memset(check, 0, sizeof(check));
+	if (fread(check, 1, sizeof(check), f) != sizeof(block)) {
+		printf("fread returned wrong length\n");
+		exit(1);
+	}
+	if (memcmp(block, check, sizeof(block)) != 0) {
+		printf("fread returned wrong data\n");
+		exit(1);
+	}
+
+	/* Seek within and beyond the read buffer */
+	for (i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+		long o = offsets[i];
+
+		if (fseek(f, o, SEEK_SET) != 0) {
+			printf("fseek to %ld failed\n", o);
+			exit(1);
+		}
+		if (ftell(f) != o) {
+			printf("ftell returned %ld instead of %ld\n", ftell(f), o);
+			exit(1);
+		}
+		c = getc(f);
+		if (c != (unsigned char) block[o]) {
+			printf("read %d at %ld instead of %d\n", c, o, (unsigned char) block[o]);
+			exit(1);
+		}
+		if (fseek(f, -1, SEEK_CUR) != 0 || getc(f) != c) {
+			printf("SEEK_CUR at %ld failed\n", o);
+			exit(1);
+		}
+	}
+	if (fseek(f, -1, SEEK_END) != 0 || getc(f) != (unsigned char) block[sizeof(block) - 1]) {
+		printf("SEEK_END failed\n");
+		exit(1);
+	}
+	rewind(f);
+	if (ftell(f) != 0 || getc(f) != (unsigned char) block[0]) {
+		printf("rewind failed\n");
+		exit(1);
+	}
+	fclose(f);
+
+	/* stderr has its own buffer, so setvbuf on it must not touch stdout */
+	if (stderr == stdout) {
+		printf("stderr is an alias of stdout\n");
+		exit(1);
+	}
+	if (setvbuf(stderr, NULL, _IOLBF, 64) != 0 || fflush(stderr) != 0) {
+		printf("setvbuf on stderr failed\n");
+		exit(1);
+	}
 	printf("success\n");
 	exit(0);
 }
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/*
+ * Exercise the minimal printf variant, which is otherwise only
+ * reached through a link-time symbol swap.
+ */
+
+int __m_vfprintf(FILE *stream, const char *fmt, va_list ap);
+
+static char out[256];
+static size_t out_len;
+
+static int
+out_put(char c, FILE *file)
+{
+	(void) file;
+	if (out_len < sizeof(out) - 1)
+		out[out_len++] = c;
+	return 0;
+}
+
+static FILE out_file = FDEV_SETUP_STREAM(out_put, NULL, NULL, _FDEV_SETUP_WRITE);
+
+static int
+check(const char *want, const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	out_len = 0;
+	memset(out, 0, sizeof(out));
+	va_start(ap, fmt);
+	ret = __m_vfprintf(&out_file, fmt, ap);
+	va_end(ap);
+	if (strcmp(out, want) != 0 || ret != (int) strlen(want)) {
+		printf("\"%s\": got \"%s\" (%d), want \"%s\"\n", fmt, out, ret, want);
+		return 1;
+	}
+	return 0;
+}
+
+int
+main(void)
+{
+	int error = 0;
+
+	error |= check("", "");
+	error |= check("plain text", "plain text");
+	error |= check("100%", "100%%");
+	error |= check("a -42 b", "a %d b", -42);
+	error |= check("[str|Z]", "[%s|%c]", "str", 'Z');
+	error |= check("beef BEEF 17 10", "%x %X %u %o", 0xbeef, 0xbeef, 17u, 8);
+	error |= check("0x1f 012", "%#x %#o", 0x1f, 10);
+	error |= check("-1234567", "%ld", -1234567L);
+	error |= check("ab? cd", "ab%f cd", 1.5);
+	return error;
+}
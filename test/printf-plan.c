@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static char out[256];
+static size_t out_len;
+
+static int
+out_put(char c, FILE *file)
+{
+	(void) file;
+	if (out_len < sizeof(out) - 1)
+		out[out_len++] = c;
+	return 0;
+}
+
+static FILE out_file = FDEV_SETUP_STREAM(out_put, NULL, NULL, _FDEV_SETUP_WRITE);
+
+static void
+out_reset(void)
+{
+	out_len = 0;
+	memset(out, 0, sizeof(out));
+}
+
+static int result;
+
+#define check(fmt, ...) do {						\
+		char expect[256];					\
+		struct printf_op plan[8];				\
+		int n, ret;						\
+		snprintf(expect, sizeof(expect), fmt, __VA_ARGS__);	\
+		n = printf_plan_compile(plan, 8, fmt);			\
+		if (n <= 0 || n > 8) {					\
+			printf("compile \"%s\" returned %d\n", fmt, n);	\
+			result++;					\
+			break;						\
+		}							\
+		out_reset();						\
+		ret = fprintf_plan(&out_file, plan, __VA_ARGS__);	\
+		if (strcmp(out, expect) != 0 || ret != (int) strlen(expect)) { \
+			printf("plan \"%s\": \"%s\" (%d) expected \"%s\"\n", fmt, out, ret, expect); \
+			result++;					\
+		}							\
+		out_reset();						\
+		fprintf_planned(&out_file, fmt, __VA_ARGS__);		\
+		if (strcmp(out, expect) != 0) {				\
+			printf("planned \"%s\": \"%s\" expected \"%s\"\n", fmt, out, expect); \
+			result++;					\
+		}							\
+	} while (0)
+
+int
+main(void)
+{
+	struct printf_op plan[2];
+	int i;
+
+	/* Run each twice so fprintf_planned reuses its plan */
+	for (i = 0; i < 2; i++) {
+		check("plain text%s", "");
+		check("%d%%%u", -12, 34u);
+		check("a=%5d b=%-5x| c=%#o", 42, 0xbeef, 8);
+		check("[%*d] [%-*d] [%.*s]", 6, 12, 4, 3, 3, "abcdef");
+		check("%08d|%.3d|%+d|% d", 7, 7, 5, 5);
+		check("%c%s%c", '<', "middle", '>');
+		check("%lld %llx %hd %hhu", -1234567890123LL, 0x123456789abcULL, (short) -3, (unsigned char) 200);
+		check("%ld %lu %p", -100000L, 100000UL, (void *) 0x1234);
+		check("%.3f %e %g %10.4G", 3.14159, 1e10, 0.0001, 123456.789);
+		check("tail %d and more text after", 1);
+	}
+
+	/* Short plans report the length needed */
+	if (printf_plan_compile(plan, 2, "%d %d %d") != 4) {
+		printf("short plan length wrong\n");
+		result++;
+	}
+
+	/* Malformed formats are rejected */
+	if (printf_plan_compile(plan, 2, "%..d") != -1) {
+		printf("malformed format accepted\n");
+		result++;
+	}
+
+	return result;
+}
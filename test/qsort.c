@@ -0,0 +1,290 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <setjmp.h>
+
+/*
+ * Sort arrays of several element sizes and input patterns, including
+ * the ones which push quicksort towards its worst case, and check
+ * that the results are ordered permutations of the input. Comparisons
+ * are counted to make sure the worst case stays O(n log n). Broken
+ * comparison functions must still leave a permutation of the input
+ * without touching anything outside the array.
+ */
+
+#define MAX_N		5000
+#define MAX_SIZE	24
+
+static unsigned char	data[MAX_N * MAX_SIZE + 8] __attribute__((aligned(16)));
+static unsigned long	counts[MAX_N];
+static size_t		elem_size;
+static unsigned long	ncmp;
+
+static uint32_t
+key_at(const void *p)
+{
+	uint32_t k;
+	memcpy(&k, p, sizeof(k));
+	return k;
+}
+
+static int
+cmp(const void *a, const void *b)
+{
+	uint32_t ka = key_at(a), kb = key_at(b);
+
+	ncmp++;
+	return (ka > kb) - (ka < kb);
+}
+
+static int
+cmp_r(const void *a, const void *b, void *thunk)
+{
+	(*(unsigned long *) thunk)++;
+	return cmp(a, b);
+}
+
+enum pattern {
+	RANDOM, SORTED, REVERSED, EQUAL, FEW, ORGAN_PIPE, SAWTOOTH, PUSH_FRONT, NPATTERN
+};
+
+static const char *const pattern_names[] = {
+	"random", "sorted", "reversed", "equal", "few", "organ-pipe", "sawtooth", "push-front"
+};
+
+static uint32_t
+pattern_key(enum pattern pat, size_t i, size_t n)
+{
+	switch (pat) {
+	case RANDOM:
+		return (uint32_t) random();
+	case SORTED:
+		return (uint32_t) i;
+	case REVERSED:
+		return (uint32_t) (n - i);
+	case EQUAL:
+		return 42;
+	case FEW:
+		return (uint32_t) (random() % 4);
+	case ORGAN_PIPE:
+		return (uint32_t) (i < n / 2 ? i : n - i);
+	case SAWTOOTH:
+		return (uint32_t) (i % 17);
+	case PUSH_FRONT:
+		return (uint32_t) (i == n - 1 ? 0 : i + 1);
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Each element holds its key followed by bytes derived from the key,
+ * which lets the check spot elements torn apart by a bad swap
+ */
+static void
+fill(unsigned char *base, enum pattern pat, size_t n, size_t size)
+{
+	size_t i, j;
+
+	memset(counts, 0, sizeof(counts));
+	for (i = 0; i < n; i++) {
+		uint32_t k = pattern_key(pat, i, n) % MAX_N;
+		unsigned char *e = base + i * size;
+
+		memcpy(e, &k, sizeof(k));
+		for (j = sizeof(k); j < size; j++)
+			e[j] = (unsigned char) (k * 7 + j);
+		counts[k]++;
+	}
+}
+
+static int
+check(const unsigned char *base, size_t n, size_t size, int ordered)
+{
+	size_t i, j;
+
+	for (i = 0; i < n; i++) {
+		const unsigned char *e = base + i * size;
+		uint32_t k = key_at(e);
+
+		if (ordered && i > 0 && key_at(e - size) > k)
+			return 1;
+		for (j = sizeof(k); j < size; j++)
+			if (e[j] != (unsigned char) (k * 7 + j))
+				return 1;
+		if (counts[k]-- == 0)
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * A comparison function which answers correctly for a while and then
+ * claims every element is less (or greater) than every other. Sorting
+ * with it once for every possible switch point catches each
+ * partitioning scan relying on a sentinel which is no longer there.
+ * Leaving the array jumps straight back out instead of running off.
+ */
+static const unsigned char	*broken_base;
+static size_t			broken_n;
+static unsigned long		broken_after;
+static int			broken_sign;
+static jmp_buf			broken_jmp;
+
+static int
+cmp_broken(const void *a, const void *b)
+{
+	const unsigned char *pa = a, *pb = b;
+	size_t len = broken_n * elem_size;
+
+	if (pa < broken_base || pa >= broken_base + len || (pa - broken_base) % elem_size ||
+	    pb < broken_base || pb >= broken_base + len || (pb - broken_base) % elem_size)
+		longjmp(broken_jmp, 1);
+	if (ncmp++ < broken_after)
+		return cmp(a, b);
+	return broken_sign;
+}
+
+static int
+check_broken(void)
+{
+	static const size_t sizes[] = { 4, 8, 12 };
+	static const size_t lengths[] = { 100, 200 };
+	int error = 0;
+	unsigned s, l;
+
+	for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		elem_size = sizes[s];
+		for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+			unsigned long total;
+
+			broken_base = data;
+			broken_n = lengths[l];
+
+			/* count the comparisons in a normal sort */
+			srandom(broken_n);
+			fill(data, RANDOM, broken_n, elem_size);
+			ncmp = 0;
+			qsort(data, broken_n, elem_size, cmp);
+			total = ncmp;
+
+			for (broken_sign = -1; broken_sign <= 1; broken_sign += 2) {
+				for (broken_after = 0; broken_after < total; broken_after++) {
+					const char *what = NULL;
+
+					srandom(broken_n);
+					fill(data, RANDOM, broken_n, elem_size);
+					ncmp = 0;
+					if (setjmp(broken_jmp))
+						what = "outside array";
+					else {
+						qsort(data, broken_n, elem_size, cmp_broken);
+						if (check(data, broken_n, elem_size, 0))
+							what = "not a permutation";
+					}
+					if (what) {
+						printf("qsort broken after %lu sign %d size %zu n %zu: %s\n",
+						       broken_after, broken_sign, elem_size, broken_n, what);
+						error = 1;
+						break;
+					}
+				}
+			}
+		}
+	}
+	return error;
+}
+
+int
+main(void)
+{
+	static const size_t sizes[] = { 4, 5, 8, 12, 16, 24 };
+	static const size_t lengths[] = { 0, 1, 2, 3, 7, 15, 16, 17, 100, 129, 1000, MAX_N };
+	static const size_t offsets[] = { 0, 4 };
+	int error = 0;
+	unsigned s, l, o;
+	int pat;
+
+	for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		for (o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+			unsigned char *base = data + offsets[o];
+
+			elem_size = sizes[s];
+			for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+				size_t n = lengths[l];
+				unsigned long limit = 0, m;
+
+				/* a generous n log2 n bound */
+				for (m = n; m > 1; m >>= 1)
+					limit += 4 * n;
+				limit += 4 * n;
+
+				for (pat = 0; pat < NPATTERN; pat++) {
+					unsigned long thunk_cmp = 0;
+
+					fill(base, (enum pattern) pat, n, elem_size);
+					ncmp = 0;
+					qsort(base, n, elem_size, cmp);
+					if (check(base, n, elem_size, 1)) {
+						printf("qsort %s size %zu offset %zu n %zu: not sorted\n",
+						       pattern_names[pat], elem_size, offsets[o], n);
+						error = 1;
+					}
+					if (ncmp > limit) {
+						printf("qsort %s size %zu n %zu: %lu comparisons\n",
+						       pattern_names[pat], elem_size, n, ncmp);
+						error = 1;
+					}
+
+					fill(base, (enum pattern) pat, n, elem_size);
+					ncmp = 0;
+					qsort_r(base, n, elem_size, cmp_r, &thunk_cmp);
+					if (check(base, n, elem_size, 1) || thunk_cmp != ncmp) {
+						printf("qsort_r %s size %zu offset %zu n %zu: not sorted\n",
+						       pattern_names[pat], elem_size, offsets[o], n);
+						error = 1;
+					}
+				}
+			}
+		}
+	}
+	error |= check_broken();
+	return error;
+}
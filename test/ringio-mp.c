@@ -0,0 +1,249 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Drive several producers through the ring protocol with the
+ * reserve, fill and drain steps interleaved at random, as preemption
+ * would. The drained stream must always be a prefix of the records in
+ * reservation order, even while later records are committed before
+ * earlier ones, and a producer facing a ring held full by an open
+ * reservation must give up instead of spinning forever. A producer
+ * facing a ring held full while another thread sits in a slow drain
+ * callback must wait for it instead.
+ */
+
+static void slow_drain_wait(void);
+
+#define RING_WAIT()	slow_drain_wait()
+
+#include "../newlib/libc/tinystdio/ringio.c"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NPROD	4
+#define NSTEP	4000
+#define MAXREC	40
+
+static __ungetc_t ring_buf[128 / sizeof(__ungetc_t)];
+
+static struct rec {
+	uint8_t		prod;
+	uint8_t		len;
+	uint16_t	seq;
+} log_rec[NSTEP + 16];
+static int nlog;
+
+/* Position of the next drained byte */
+static int out_rec;
+static int out_off;
+static int bad;
+
+static uint32_t seed = 1;
+
+static uint32_t
+rnd(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+/* Never zero, so an unfilled reservation can't pass for data */
+static char
+rec_byte(const struct rec *r, int i)
+{
+	return (char) (1 + (r->prod * 61 + r->seq * 7 + i) % 250);
+}
+
+static int
+check_drain(const char *buf, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (out_rec >= nlog || buf[i] != rec_byte(&log_rec[out_rec], out_off)) {
+			if (!bad)
+				printf("drained byte %u of record %d is wrong\n",
+				       (unsigned) out_off, out_rec);
+			bad = 1;
+			return 0;
+		}
+		if (++out_off == log_rec[out_rec].len) {
+			out_rec++;
+			out_off = 0;
+		}
+	}
+	return 0;
+}
+
+static struct __file_ring ring = FDEV_SETUP_RING(ring_buf, sizeof(ring_buf), check_drain);
+
+static struct {
+	int		open;
+	int		rec;
+	__ungetc_t	pos;
+	uint16_t	seq;
+} prod[NPROD];
+
+/*
+ * Stands in for another thread inside the drain callback: the ring
+ * stays draining for SLOW_WAITS passes of the waiting producer, far
+ * longer than RING_RESERVE_TRIES, then the drain completes.
+ */
+#define SLOW_WAITS	(10 * RING_RESERVE_TRIES)
+
+static int slow_active;
+static long slow_waits;
+
+static void
+slow_drain_wait(void)
+{
+	if (!slow_active)
+		return;
+	if (++slow_waits == SLOW_WAITS) {
+		slow_active = 0;
+		ring.draining = 0;
+		ring_drain(&ring);
+	}
+}
+
+static void
+fill(int p)
+{
+	char data[MAXREC];
+	struct rec *r = &log_rec[prod[p].rec];
+	int i;
+
+	for (i = 0; i < r->len; i++)
+		data[i] = rec_byte(r, i);
+	ring_fill(&ring, prod[p].pos, data, r->len);
+	prod[p].open = 0;
+}
+
+int
+main(void)
+{
+	int step, p, drops = 0, ret = 0;
+
+	/* A later record committed first must wait for the earlier one */
+	prod[0].rec = nlog;
+	log_rec[nlog++] = (struct rec) { .prod = 0, .len = 10, .seq = prod[0].seq++ };
+	prod[1].rec = nlog;
+	log_rec[nlog++] = (struct rec) { .prod = 1, .len = 20, .seq = prod[1].seq++ };
+	if (ring_reserve(&ring, 10, &prod[0].pos) < 0 ||
+	    ring_reserve(&ring, 20, &prod[1].pos) < 0) {
+		printf("reserve failed on an empty ring\n");
+		return 1;
+	}
+	fill(1);
+	ring_drain(&ring);
+	if (out_rec != 0 || out_off != 0) {
+		printf("drained past an open reservation\n");
+		return 1;
+	}
+	fill(0);
+	ring_drain(&ring);
+	if (out_rec != 2 || bad) {
+		printf("committed records were not drained in order\n");
+		return 1;
+	}
+
+	for (step = 0; step < NSTEP - 2 && nlog < NSTEP; step++) {
+		p = rnd() % (NPROD + 1);
+		if (p == NPROD) {
+			ring_drain(&ring);
+		} else if (prod[p].open) {
+			fill(p);
+		} else {
+			struct rec r = { .prod = p, .len = 1 + rnd() % MAXREC, .seq = prod[p].seq };
+
+			/* Fails when the other producers hold the ring full */
+			if (ring_reserve(&ring, r.len, &prod[p].pos) < 0) {
+				drops++;
+				continue;
+			}
+			prod[p].seq++;
+			prod[p].open = 1;
+			prod[p].rec = nlog;
+			log_rec[nlog++] = r;
+		}
+		if (bad)
+			return 1;
+	}
+
+	for (p = 0; p < NPROD; p++)
+		if (prod[p].open)
+			fill(p);
+	ring_drain(&ring);
+	if (bad || out_rec != nlog || out_off != 0) {
+		printf("drained %d of %d records\n", out_rec, nlog);
+		ret = 1;
+	}
+
+	/* Fill the ring with committed records while a slow drain runs */
+	ring.draining = 1;
+	for (;;) {
+		struct rec r = { .prod = 0, .len = 20, .seq = prod[0].seq };
+		int full = (__ungetc_t) (ring.size - (__ungetc_t) (ring.head - ring.tail)) <
+			ring_span(r.len);
+
+		if (full)
+			slow_active = 1;
+		if (ring_reserve(&ring, r.len, &prod[0].pos) < 0) {
+			printf("record dropped during a slow drain\n");
+			return 1;
+		}
+		prod[0].seq++;
+		prod[0].rec = nlog;
+		log_rec[nlog++] = r;
+		fill(0);
+		if (full)
+			break;
+	}
+	if (slow_waits != SLOW_WAITS) {
+		printf("producer waited %ld passes for the slow drain\n", slow_waits);
+		ret = 1;
+	}
+	ring_drain(&ring);
+	if (bad || out_rec != nlog || out_off != 0) {
+		printf("drained %d of %d records after a slow drain\n", out_rec, nlog);
+		ret = 1;
+	}
+	if (drops == 0) {
+		printf("ring never filled up\n");
+		ret = 1;
+	}
+	printf("%d records, %d dropped reservations\n", nlog, drops);
+	return ret;
+}
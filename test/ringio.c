@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static __ungetc_t ring_buf[64 / sizeof(__ungetc_t)];
+static char out[1024];
+static size_t out_len;
+
+static int
+ring_drain(const char *buf, size_t len)
+{
+	if (out_len + len > sizeof(out))
+		return EOF;
+	memcpy(out + out_len, buf, len);
+	out_len += len;
+	return 0;
+}
+
+static struct __file_ring ring = FDEV_SETUP_RING(ring_buf, sizeof(ring_buf), ring_drain);
+
+int
+main(void)
+{
+	FILE *f = &ring.file;
+	char expect[sizeof(out)];
+	size_t expect_len = 0;
+	int i;
+
+	/* Enough lines to wrap the ring several times */
+	for (i = 0; i < 20; i++) {
+		fprintf(f, "line %d of %s\n", i, "ring test");
+		expect_len += sprintf(expect + expect_len, "line %d of %s\n", i, "ring test");
+	}
+
+	/* A partial line stays with the thread until flushed */
+	fputs("no newline", f);
+	expect_len += sprintf(expect + expect_len, "no newline");
+	fdev_ring_drain(f);
+	if (out_len == expect_len) {
+		printf("partial line drained early\n");
+		exit(1);
+	}
+
+	/* Longer than both the line buffer and the ring */
+	memset(expect + expect_len, 'x', 200);
+	fwrite(expect + expect_len, 1, 200, f);
+	expect_len += 200;
+
+	fflush(f);
+	if (out_len != expect_len || memcmp(out, expect, expect_len) != 0) {
+		printf("ring output mismatch: got %u bytes, expected %u\n",
+		       (unsigned) out_len, (unsigned) expect_len);
+		exit(1);
+	}
+	printf("success\n");
+	exit(0);
+}
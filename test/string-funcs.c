@@ -0,0 +1,498 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+/*
+ * Check the string and memory functions against simple byte-at-a-time
+ * versions over all alignments and a range of lengths, so that
+ * word-at-a-time and vector implementations see every combination of
+ * head, body and tail
+ */
+
+#define MAX_ALIGN	64
+#define MAX_LEN		300
+#define BUF_SIZE	(MAX_ALIGN + MAX_LEN + MAX_ALIGN)
+
+static unsigned char buf1[BUF_SIZE] __attribute__((aligned(MAX_ALIGN)));
+static unsigned char buf2[BUF_SIZE] __attribute__((aligned(MAX_ALIGN)));
+static unsigned char buf3[BUF_SIZE] __attribute__((aligned(MAX_ALIGN)));
+
+static size_t
+ref_strlen(const unsigned char *s)
+{
+	size_t n = 0;
+	while (s[n])
+		n++;
+	return n;
+}
+
+static const unsigned char *
+ref_memchr(const unsigned char *s, int c, size_t n)
+{
+	for (; n--; s++)
+		if (*s == (unsigned char) c)
+			return s;
+	return NULL;
+}
+
+static const unsigned char *
+ref_memrchr(const unsigned char *s, int c, size_t n)
+{
+	while (n--)
+		if (s[n] == (unsigned char) c)
+			return s + n;
+	return NULL;
+}
+
+static size_t
+ref_strspn(const unsigned char *s, const unsigned char *set, int accept)
+{
+	size_t n;
+
+	for (n = 0; s[n]; n++)
+		if ((strchr((const char *) set, s[n]) != NULL) != accept)
+			break;
+	return n;
+}
+
+static const unsigned char *
+ref_strchr(const unsigned char *s, int c)
+{
+	for (;; s++) {
+		if (*s == (unsigned char) c)
+			return s;
+		if (!*s)
+			return NULL;
+	}
+}
+
+#define LARGE_SIZE	(64 * 1024)
+
+#ifdef __x86_64__
+/*
+ * Lower the size thresholds in the x86_64 memcpy and memset so that
+ * the rep movsb and non-temporal paths are exercised too
+ */
+extern size_t __x86_64_rep_movsb_threshold;
+extern size_t __x86_64_non_temporal_threshold;
+extern unsigned int __x86_64_memcpy_features;
+#endif
+
+static int
+sign(int v)
+{
+	return (v > 0) - (v < 0);
+}
+
+static void
+fill(unsigned char *b, unsigned seed)
+{
+	size_t i;
+	for (i = 0; i < BUF_SIZE; i++)
+		b[i] = (unsigned char) (((i + seed) * 37) % 251 + 1);
+}
+
+#define WMAX_ALIGN	16
+#define WMAX_LEN	100
+
+static wchar_t wbuf1[WMAX_ALIGN + WMAX_LEN + WMAX_ALIGN] __attribute__((aligned(64)));
+static wchar_t wbuf2[WMAX_ALIGN + WMAX_LEN + WMAX_ALIGN] __attribute__((aligned(64)));
+
+static void
+wfill(wchar_t *b, unsigned seed)
+{
+	size_t i;
+	for (i = 0; i < WMAX_ALIGN + WMAX_LEN + WMAX_ALIGN; i++)
+		b[i] = (wchar_t) (((i + seed) * 0x1234567) % 0x7ffffff0 + 1);
+}
+
+/*
+ * The wide character functions work on aligned arrays, so check
+ * every element offset rather than every byte offset
+ */
+static int
+check_wide(void)
+{
+	size_t	a, b, len, pos, i;
+	int	error = 0;
+
+	for (a = 0; a < WMAX_ALIGN; a++) {
+		for (len = 0; len < WMAX_LEN; len++) {
+			wchar_t *s = wbuf1 + a;
+
+			wfill(wbuf1, 0);
+			s[len] = L'\0';
+			if (wcslen(s) != len) {
+				printf("wcslen align %zu len %zu: %zu\n", a, len, wcslen(s));
+				error = 1;
+			}
+			for (pos = 0; pos <= len; pos++) {
+				if (wmemchr(s, s[pos], len) != (pos < len ? s + pos : NULL)) {
+					printf("wmemchr align %zu len %zu pos %zu\n", a, len, pos);
+					error = 1;
+				}
+			}
+
+			for (b = 0; b < WMAX_ALIGN; b += 3) {
+				wchar_t *t = wbuf2 + b;
+
+				wfill(wbuf2, 7);
+				wmemset(t, (wchar_t) (len + 0x12345), len);
+				for (i = 0; i < len; i++) {
+					if (t[i] != (wchar_t) (len + 0x12345)) {
+						printf("wmemset align %zu len %zu\n", b, len);
+						error = 1;
+						break;
+					}
+				}
+				if (b > 0 && t[-1] == (wchar_t) (len + 0x12345)) {
+					printf("wmemset underrun align %zu len %zu\n", b, len);
+					error = 1;
+				}
+				if (t[len] == (wchar_t) (len + 0x12345)) {
+					printf("wmemset overrun align %zu len %zu\n", b, len);
+					error = 1;
+				}
+
+				memcpy(t, s, (len + 1) * sizeof(wchar_t));
+				if (wcscmp(s, t) != 0) {
+					printf("wcscmp equal align %zu %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+				for (pos = 0; pos < len; pos += (pos < 20 ? 1 : 7)) {
+					wchar_t save = t[pos];
+
+					t[pos] = 0x7ffffff8;
+					if (wcscmp(s, t) >= 0 || wcscmp(t, s) <= 0) {
+						printf("wcscmp align %zu %zu len %zu pos %zu\n", a, b, len, pos);
+						error = 1;
+					}
+					t[pos] = save;
+				}
+				if (len > 0) {
+					t[len - 1] = L'\0';
+					if (wcscmp(s, t) <= 0) {
+						printf("wcscmp prefix align %zu %zu len %zu\n", a, b, len);
+						error = 1;
+					}
+				}
+			}
+		}
+	}
+	return error;
+}
+
+/*
+ * Copy, move and set large blocks, covering the loops in the larger
+ * size tiers
+ */
+static int
+check_large(void)
+{
+	unsigned char	*src = malloc(LARGE_SIZE + MAX_ALIGN);
+	unsigned char	*dst = malloc(LARGE_SIZE + MAX_ALIGN);
+	unsigned char	*ref = malloc(LARGE_SIZE + MAX_ALIGN);
+	size_t		a, b, len, i;
+	int		error = 0;
+
+	if (!src || !dst || !ref) {
+		printf("malloc failed\n");
+		return 1;
+	}
+	for (a = 0; a < MAX_ALIGN; a += 13) {
+		for (b = 0; b < MAX_ALIGN; b += 11) {
+			for (len = 256; len <= LARGE_SIZE; len = len * 3 + b) {
+				for (i = 0; i < LARGE_SIZE + MAX_ALIGN; i++) {
+					src[i] = (unsigned char) (i * 7 + a);
+					dst[i] = ref[i] = (unsigned char) (i * 13 + b);
+				}
+				memcpy(dst + b, src + a, len);
+				for (i = 0; i < len; i++)
+					ref[b + i] = src[a + i];
+				if (memcmp(dst, ref, LARGE_SIZE + MAX_ALIGN) != 0) {
+					printf("large memcpy align %zu %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+
+				memset(dst + b, (int) a, len);
+				for (i = 0; i < len; i++)
+					ref[b + i] = (unsigned char) a;
+				if (memcmp(dst, ref, LARGE_SIZE + MAX_ALIGN) != 0) {
+					printf("large memset align %zu len %zu\n", b, len);
+					error = 1;
+				}
+
+				/* overlapping moves in both directions */
+				if (len + MAX_ALIGN > LARGE_SIZE)
+					continue;
+				memcpy(dst, src, LARGE_SIZE + MAX_ALIGN);
+				memcpy(ref, src, LARGE_SIZE + MAX_ALIGN);
+				memmove(dst + b, dst + a, len);
+				memmove(ref + b, src + a, len);
+				if (memcmp(dst, ref, LARGE_SIZE + MAX_ALIGN) != 0) {
+					printf("large memmove from %zu to %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+			}
+		}
+	}
+	free(src);
+	free(dst);
+	free(ref);
+	return error;
+}
+
+int
+main(void)
+{
+	int	error = 0;
+	size_t	a, b, len, pos;
+
+	for (a = 0; a < MAX_ALIGN; a++) {
+		for (len = 0; len < MAX_LEN; len++) {
+			unsigned char *s = buf1 + a;
+
+			fill(buf1, 0);
+			s[len] = '\0';
+			if (strlen((char *) s) != ref_strlen(s)) {
+				printf("strlen align %zu len %zu: %zu\n", a, len, strlen((char *) s));
+				error = 1;
+			}
+
+			/* characters before, at, and after the terminator */
+			for (pos = 0; pos < len + 2 && pos < MAX_LEN; pos += (pos < 40 ? 1 : 17)) {
+				int c = s[pos];
+				if ((unsigned char *) strchr((char *) s, c) != ref_strchr(s, c)) {
+					printf("strchr align %zu len %zu pos %zu\n", a, len, pos);
+					error = 1;
+				}
+				if (memchr(s, c, len) != ref_memchr(s, c, len)) {
+					printf("memchr align %zu len %zu pos %zu\n", a, len, pos);
+					error = 1;
+				}
+				if (memrchr(s, c, len) != ref_memrchr(s, c, len)) {
+					printf("memrchr align %zu len %zu pos %zu\n", a, len, pos);
+					error = 1;
+				}
+			}
+			if ((unsigned char *) strchr((char *) s, 0x80) != ref_strchr(s, 0x80) ||
+			    memchr(s, 0x180, len) != ref_memchr(s, 0x180, len)) {
+				printf("strchr/memchr high byte align %zu len %zu\n", a, len);
+				error = 1;
+			}
+		}
+	}
+
+	for (a = 0; a < MAX_ALIGN; a += 3) {
+		for (b = 0; b < MAX_ALIGN; b += 5) {
+			for (len = 0; len < MAX_LEN; len += (len < 70 ? 1 : 23)) {
+				unsigned char *s1 = buf1 + a, *s2 = buf2 + b;
+
+				fill(buf1, a);
+				memcpy(s2, s1, len + 1);
+				s1[len] = s2[len] = '\0';
+				if (memcmp(s1, s2, len) != 0 || strcmp((char *) s1, (char *) s2) != 0) {
+					printf("equal compare align %zu %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+				for (pos = 0; pos < len; pos += (pos < 40 ? 1 : 13)) {
+					unsigned char save = s2[pos];
+					int expect;
+
+					/* exercise both orders, including bytes above 0x7f */
+					s2[pos] = (unsigned char) (save + 0x80);
+					expect = sign((int) s1[pos] - (int) s2[pos]);
+					if (sign(memcmp(s1, s2, len)) != expect ||
+					    sign(strcmp((char *) s1, (char *) s2)) != expect ||
+					    sign(strcmp((char *) s2, (char *) s1)) != -expect)
+					{
+						printf("compare align %zu %zu len %zu pos %zu\n", a, b, len, pos);
+						error = 1;
+					}
+					s2[pos] = save;
+				}
+				if (len > 0) {
+					/* one string ends early */
+					s2[len - 1] = '\0';
+					if (sign(strcmp((char *) s1, (char *) s2)) != 1) {
+						printf("strcmp prefix align %zu %zu len %zu\n", a, b, len);
+						error = 1;
+					}
+				}
+			}
+		}
+	}
+
+	/* overlapping moves in both directions */
+	for (a = 0; a < MAX_ALIGN; a += 3) {
+		for (b = 0; b < MAX_ALIGN + 20; b += 7) {
+			for (len = 0; len < MAX_LEN - MAX_ALIGN; len += (len < 70 ? 1 : 19)) {
+				fill(buf1, 3);
+				memcpy(buf3, buf1, BUF_SIZE);
+				memcpy(buf2, buf1 + a, len);
+				memmove(buf1 + b, buf1 + a, len);
+				memcpy(buf3 + b, buf2, len);
+				if (memcmp(buf1, buf3, BUF_SIZE) != 0) {
+					printf("memmove from %zu to %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+			}
+		}
+	}
+
+	/* spans over sets taken from the string itself, plus some absent bytes */
+	for (a = 0; a < MAX_ALIGN; a++) {
+		for (len = 0; len < MAX_LEN - MAX_ALIGN; len += (len < 40 ? 1 : 13)) {
+			static const size_t set_lens[] = { 0, 1, 2, 5, 17, 64 };
+			unsigned char *s = buf1 + a;
+			unsigned char set[80];
+			size_t l, i;
+
+			fill(buf1, 13);
+			s[len] = '\0';
+			for (l = 0; l < sizeof(set_lens) / sizeof(set_lens[0]); l++) {
+				for (i = 0; i < set_lens[l]; i++)
+					set[i] = (i & 1) ? (unsigned char) (0xff - i) : buf1[(i * 7) % BUF_SIZE];
+				set[i] = '\0';
+				if (strspn((char *) s, (char *) set) != ref_strspn(s, set, 1) ||
+				    strcspn((char *) s, (char *) set) != ref_strspn(s, set, 0))
+				{
+					printf("strspn/strcspn align %zu len %zu set %zu\n", a, len, set_lens[l]);
+					error = 1;
+				}
+				pos = ref_strspn(s, set, 0);
+				if (strpbrk((char *) s, (char *) set) != (s[pos] ? (char *) s + pos : NULL)) {
+					printf("strpbrk align %zu len %zu set %zu\n", a, len, set_lens[l]);
+					error = 1;
+				}
+			}
+		}
+	}
+
+	error |= check_wide();
+
+	/* strncpy with the terminator before, at and past the limit */
+	for (a = 0; a < MAX_ALIGN; a += 5) {
+		for (b = 0; b < MAX_ALIGN; b += 3) {
+			for (len = 0; len < MAX_LEN - MAX_ALIGN; len += (len < 40 ? 1 : 21)) {
+				size_t n;
+
+				for (n = 0; n < MAX_LEN - MAX_ALIGN; n += (n < 40 ? 1 : 29)) {
+					fill(buf1, 7);
+					fill(buf2, 11);
+					memcpy(buf3, buf2, BUF_SIZE);
+					buf1[a + len] = '\0';
+					if (strncpy((char *) buf2 + b, (char *) buf1 + a, n) != (char *) buf2 + b) {
+						printf("strncpy return align %zu %zu len %zu n %zu\n", a, b, len, n);
+						error = 1;
+					}
+					for (pos = 0; pos < n; pos++)
+						buf3[b + pos] = pos < len ? buf1[a + pos] : '\0';
+					if (memcmp(buf2, buf3, BUF_SIZE) != 0) {
+						printf("strncpy align %zu %zu len %zu n %zu\n", a, b, len, n);
+						error = 1;
+					}
+					fill(buf2, 11);
+					if (stpncpy((char *) buf2 + b, (char *) buf1 + a, n) !=
+					    (char *) buf2 + b + (len < n ? len : n) ||
+					    memcmp(buf2, buf3, BUF_SIZE) != 0)
+					{
+						printf("stpncpy align %zu %zu len %zu n %zu\n", a, b, len, n);
+						error = 1;
+					}
+				}
+			}
+		}
+	}
+
+	/* copies and stores at every alignment, checking the bytes around them */
+	for (a = 0; a < MAX_ALIGN; a += 3) {
+		for (b = 0; b < MAX_ALIGN; b++) {
+			for (len = 0; len < MAX_LEN; len += (len < 80 ? 1 : 11)) {
+				fill(buf1, 5);
+				fill(buf2, 9);
+				memcpy(buf3, buf2, BUF_SIZE);
+				if (memcpy(buf2 + b, buf1 + a, len) != buf2 + b) {
+					printf("memcpy return align %zu %zu len %zu\n", a, b, len);
+					error = 1;
+				}
+				memcpy(buf3 + b, buf1 + a, len);
+				for (pos = 0; pos < BUF_SIZE; pos++) {
+					unsigned char expect = (pos >= b && pos < b + len) ? buf1[a + pos - b] : buf3[pos];
+					if (buf2[pos] != expect) {
+						printf("memcpy align %zu %zu len %zu pos %zu\n", a, b, len, pos);
+						error = 1;
+						break;
+					}
+				}
+
+				if (a)
+					continue;
+				fill(buf2, 9);
+				if (memset(buf2 + b, 0x1c5, len) != buf2 + b) {
+					printf("memset return align %zu len %zu\n", b, len);
+					error = 1;
+				}
+				for (pos = 0; pos < BUF_SIZE; pos++) {
+					unsigned char expect = (pos >= b && pos < b + len) ? 0xc5 : buf3[pos];
+					if (buf2[pos] != expect) {
+						printf("memset align %zu len %zu pos %zu\n", b, len, pos);
+						error = 1;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	error |= check_large();
+#ifdef __x86_64__
+	__x86_64_rep_movsb_threshold = 512;
+	__x86_64_non_temporal_threshold = 4096;
+	error |= check_large();
+	/* Take the other path below the non-temporal threshold */
+	__x86_64_memcpy_features ^= 2;
+	error |= check_large();
+	/* Non-temporal stores still apply below the rep movsb threshold */
+	__x86_64_rep_movsb_threshold = 8192;
+	error |= check_large();
+#endif
+	return error;
+}
@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The compiler converts each literal with correct rounding, so the
+ * string form of the same literal must produce the same value
+ */
+#define D(x)	{ #x, x }
+#define F(x)	{ #x, x ## f }
+
+static const struct {
+	const char	*s;
+	double		d;
+} dtests[] = {
+	D(0.1),
+	D(1.5),
+	D(12345678),
+	D(123456789),
+	D(12345678.87654321),
+	D(0.000000001234567890123),
+	D(00000000000000001),
+	D(00000000.0000000012345678),
+	D(3.14159265358979323846),
+	D(2.718281828459045),
+	D(9007199254740993),
+	D(1e23),
+	D(8.589973e9),
+	D(4.9406564584124654e-324),
+	D(2.2250738585072011e-308),
+	D(2.2250738585072014e-308),
+	D(2.225073858507201136e-308),
+	D(1.7976931348623157e308),
+	D(5e-310),
+	D(1e-300),
+	D(123456789012345678e250),
+	D(0.30000000000000004),
+};
+
+static const struct {
+	const char	*s;
+	float		f;
+} ftests[] = {
+	F(0.1),
+	F(3.14159),
+	F(16777216.0),
+	F(16777217.0),
+	F(12345678.9),
+	F(1e10),
+	F(1e-10),
+	F(1.17549435e-38),
+	F(1.1754943e-38),
+	F(3.4028235e38),
+	F(1e-45),
+	F(0.000000001),
+};
+
+int
+main(void)
+{
+	int	error = 0;
+	unsigned i;
+	char	*end;
+
+	for (i = 0; i < sizeof(dtests)/sizeof(dtests[0]); i++) {
+		double d = strtod(dtests[i].s, &end);
+		if (memcmp(&d, &dtests[i].d, sizeof(d)) != 0 || *end != '\0') {
+			printf("strtod(\"%s\") = %.17g expected %.17g\n",
+			       dtests[i].s, d, dtests[i].d);
+			error = 1;
+		}
+	}
+	for (i = 0; i < sizeof(ftests)/sizeof(ftests[0]); i++) {
+		float f = strtof(ftests[i].s, &end);
+		if (memcmp(&f, &ftests[i].f, sizeof(f)) != 0 || *end != '\0') {
+			printf("strtof(\"%s\") = %.9g expected %.9g\n",
+			       ftests[i].s, (double) f, (double) ftests[i].f);
+			error = 1;
+		}
+	}
+
+	/* The digit scanner must stop at the end of the number */
+	if (strtod("12345678x", &end) != 12345678.0 || *end != 'x') {
+		printf("strtod stopped at \"%s\"\n", end);
+		error = 1;
+	}
+	if (strtod("1234567.8e1", &end) != 12345678.0 || *end != '\0') {
+		printf("strtod exponent after digit block failed\n");
+		error = 1;
+	}
+	return error;
+}
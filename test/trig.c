@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Spot checks for sin, cos, tan and sincos: arguments near multiples
+ * of pi/2, huge arguments which need the full reduction, special
+ * values and agreement between sincos and separate sin and cos calls.
+ */
+
+static int64_t
+ordered(double x)
+{
+	int64_t i;
+
+	memcpy(&i, &x, sizeof(i));
+	return i < 0 ? INT64_MIN - i : i;
+}
+
+static int
+check(const char *name, double x, double got, double want)
+{
+	int64_t d = ordered(got) - ordered(want);
+
+	if (isnan(want) ? !isnan(got) : (d > 1 || d < -1)) {
+		printf("%s(%.17g) = %.17g, want %.17g\n", name, x, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static const struct {
+	double x, s, c, t;
+} values[] = {
+	{ 0x1.921fb54442d18p-1, 0.70710678118654746, 0.70710678118654757, 0.99999999999999989 },
+	{ 0x1.921fb54442d18p+0, 1.0, 6.123233995736766e-17, 16331239353195370.0 },
+	{ 0x1.921fb54442d18p+1, 1.2246467991473532e-16, -1.0, -1.2246467991473532e-16 },
+	{ 1.0, 0.8414709848078965, 0.54030230586813977, 1.5574077246549023 },
+	{ -3.0, -0.14112000805986721, -0.98999249660044542, 0.1425465430742778 },
+	{ 100.0, -0.50636564110975879, 0.86231887228768389, -0.58721391515692911 },
+	{ 1e6, -0.34999350217129294, 0.93675212753314474, -0.37362445398759903 },
+	{ 1e22, -0.85220084976718879, 0.52321478539513899, -1.6287782256068988 },
+	{ 0x1p1023, 0.56312777985088402, -0.82636983461414804, -0.68144764760662146 },
+};
+
+int
+main(void)
+{
+	int error = 0;
+	unsigned i;
+
+	for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		double x = values[i].x;
+		double s, c;
+
+		error |= check("sin", x, sin(x), values[i].s);
+		error |= check("cos", x, cos(x), values[i].c);
+		error |= check("tan", x, tan(x), values[i].t);
+		error |= check("sin", -x, sin(-x), -values[i].s);
+		error |= check("cos", -x, cos(-x), values[i].c);
+		sincos(x, &s, &c);
+		error |= check("sincos.sin", x, s, values[i].s);
+		error |= check("sincos.cos", x, c, values[i].c);
+	}
+
+	/* sincos must match sin and cos exactly across the reduction ranges */
+	for (i = 0; i < 20000; i++) {
+		double x = ldexp((double) (i * 2654435761u % 1000003) / 1000003.0, (int) (i % 80) - 30);
+		double s, c;
+
+		if (i & 1)
+			x = -x;
+		sincos(x, &s, &c);
+		if (s != sin(x) || c != cos(x)) {
+			printf("sincos(%.17g) = %.17g %.17g, sin %.17g cos %.17g\n",
+			       x, s, c, sin(x), cos(x));
+			error = 1;
+			break;
+		}
+	}
+
+	if (!(sin(-0.0) == 0 && signbit(sin(-0.0))) || !(tan(-0.0) == 0 && signbit(tan(-0.0)))) {
+		printf("sin/tan of -0 lost the sign\n");
+		error = 1;
+	}
+	if (cos(0.0) != 1.0 || sin(0x1p-1000) != 0x1p-1000) {
+		printf("small argument results wrong\n");
+		error = 1;
+	}
+	if (!isnan(sin(INFINITY)) || !isnan(cos(-INFINITY)) || !isnan(tan(INFINITY)) || !isnan(sin(NAN))) {
+		printf("sin/cos/tan of inf/nan not nan\n");
+		error = 1;
+	}
+	return error;
+}
@@ -0,0 +1,217 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <search.h>
+
+/*
+ * Insert, find and delete keys in increasing, decreasing and shuffled
+ * orders, checking that lookups work, that twalk sees the keys in
+ * order and that the tree stays within the AVL height bound.
+ */
+
+#define N	4096
+
+static int keys[N];
+static int order[N];
+static int max_level;
+static int last_key;
+static int walk_count;
+static int walk_error;
+
+static int
+compar(const void *a, const void *b)
+{
+	int ia = *(const int *) a, ib = *(const int *) b;
+
+	return (ia > ib) - (ia < ib);
+}
+
+static void
+action(const void *node, VISIT which, int level)
+{
+	int key = **(int *const *) node;
+
+	if (level > max_level)
+		max_level = level;
+	if (which == postorder || which == leaf) {
+		if (walk_count > 0 && key <= last_key)
+			walk_error = 1;
+		last_key = key;
+		walk_count++;
+	}
+}
+
+/* 1.44 * log2(n + 2) */
+static int
+height_bound(int n)
+{
+	int log2 = 0;
+
+	while ((1 << log2) < n + 2)
+		log2++;
+	return (log2 * 144 + 99) / 100;
+}
+
+static int
+check_tree(void *root, int n, const char *what)
+{
+	max_level = 0;
+	walk_count = 0;
+	walk_error = 0;
+	twalk(root, action);
+	if (walk_error || walk_count != n) {
+		printf("%s: walk saw %d of %d nodes%s\n", what, walk_count, n,
+		       walk_error ? " out of order" : "");
+		return 1;
+	}
+	if (n && max_level + 1 > height_bound(n)) {
+		printf("%s: height %d for %d nodes\n", what, max_level + 1, n);
+		return 1;
+	}
+	return 0;
+}
+
+static void
+shuffle(int n)
+{
+	int i;
+
+	for (i = n - 1; i > 0; i--) {
+		int j = random() % (i + 1);
+		int t = order[i];
+		order[i] = order[j];
+		order[j] = t;
+	}
+}
+
+static int
+run(const char *name, int mode)
+{
+	void *root = NULL;
+	int error = 0;
+	int remaining;
+	int i;
+
+	for (i = 0; i < N; i++)
+		order[i] = mode == 1 ? N - 1 - i : i;
+	if (mode == 2)
+		shuffle(N);
+
+	for (i = 0; i < N; i++) {
+		void *node = tsearch(&keys[order[i]], &root, compar);
+
+		if (node == NULL || *(int **) node != &keys[order[i]]) {
+			printf("%s: tsearch %d failed\n", name, order[i]);
+			return 1;
+		}
+		/* a second insert finds the existing node */
+		if (tsearch(&keys[order[i]], &root, compar) != node) {
+			printf("%s: tsearch %d added a duplicate\n", name, order[i]);
+			return 1;
+		}
+	}
+	error |= check_tree(root, N, name);
+
+	for (i = 0; i < N; i++) {
+		void *node = tfind(&keys[i], &root, compar);
+
+		if (node == NULL || *(int **) node != &keys[i]) {
+			printf("%s: tfind %d failed\n", name, i);
+			return 1;
+		}
+	}
+
+	/* remove the even keys */
+	for (i = 0; i < N; i++) {
+		int k = order[i];
+
+		if (k & 1)
+			continue;
+		if (tdelete(&keys[k], &root, compar) == NULL) {
+			printf("%s: tdelete %d failed\n", name, k);
+			return 1;
+		}
+		if (tdelete(&keys[k], &root, compar) != NULL) {
+			printf("%s: tdelete %d twice succeeded\n", name, k);
+			return 1;
+		}
+	}
+	error |= check_tree(root, N / 2, name);
+	for (i = 0; i < N; i++) {
+		void *node = tfind(&keys[i], &root, compar);
+
+		if ((node != NULL) != (i & 1)) {
+			printf("%s: tfind %d after delete wrong\n", name, i);
+			return 1;
+		}
+	}
+
+	/* and then the rest, checking the shape along the way */
+	remaining = N / 2;
+	for (i = 0; i < N; i++) {
+		int k = order[i];
+
+		if (!(k & 1))
+			continue;
+		if (tdelete(&keys[k], &root, compar) == NULL) {
+			printf("%s: tdelete %d failed\n", name, k);
+			return 1;
+		}
+		if ((--remaining & 0xff) == 0)
+			error |= check_tree(root, remaining, name);
+	}
+	if (root != NULL) {
+		printf("%s: tree not empty\n", name);
+		error = 1;
+	}
+	return error;
+}
+
+int
+main(void)
+{
+	int error = 0;
+	int i;
+
+	for (i = 0; i < N; i++)
+		keys[i] = i;
+
+	error |= run("increasing", 0);
+	error |= run("decreasing", 1);
+	error |= run("shuffled", 2);
+	return error;
+}
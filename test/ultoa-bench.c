@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compare the two digit per step decimal conversion used by printf
+ * with the original one digit per step version
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#undef PREFER_SIZE_OVER_SPEED
+typedef unsigned long long ultoa_unsigned_t;
+#define SIZEOF_ULTOA __SIZEOF_LONG_LONG__
+
+#include "../newlib/libc/tinystdio/ultoa_invert.c"
+
+char *
+ref_ultoa_invert(unsigned long long val, char *str, int base);
+
+#define NVAL	4096
+#define NREP	512
+
+static unsigned long long vals[NVAL];
+
+/* Values with evenly distributed digit counts */
+static void
+make_vals(int max_digits)
+{
+	int i;
+
+	for (i = 0; i < NVAL; i++) {
+		unsigned long long v = ((unsigned long long) random() << 33) ^
+			((unsigned long long) random() << 11) ^ random();
+		int digits = i % max_digits;
+		int d;
+
+		for (d = 19; d > digits; d--)
+			v /= 10;
+		vals[i] = v;
+	}
+}
+
+static volatile char sink;
+
+static clock_t
+run(char *(*conv)(unsigned long long, char *, int))
+{
+	char buf[24];
+	clock_t start = clock();
+	int rep, i;
+
+	for (rep = 0; rep < NREP; rep++)
+		for (i = 0; i < NVAL; i++)
+			sink = *conv(vals[i], buf, 10);
+	return clock() - start;
+}
+
+static char *
+fast_ultoa_invert(unsigned long long val, char *str, int base)
+{
+	return __ultoa_invert(val, str, base);
+}
+
+int
+main(void)
+{
+	static const struct {
+		const char	*name;
+		int		digits;
+	} sets[] = {
+		{ "32-bit", 10 },
+		{ "64-bit", 20 },
+	};
+	unsigned s;
+
+	for (s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+		clock_t fast, ref;
+
+		make_vals(sets[s].digits);
+		ref = run(ref_ultoa_invert);
+		fast = run(fast_ultoa_invert);
+		if (ref == (clock_t) -1 || fast == (clock_t) -1)
+			printf("%s: no clock available\n", sets[s].name);
+		else
+			printf("%s: reference %ld fast %ld clocks (%ld per second)\n",
+			       sets[s].name, (long) ref, (long) fast, (long) CLOCKS_PER_SEC);
+	}
+	return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check each of the __ultoa_invert variants against known strings
+ * and a plain divide loop in every base printf uses
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#undef PREFER_SIZE_OVER_SPEED
+typedef unsigned long long ultoa_unsigned_t;
+#define SIZEOF_ULTOA __SIZEOF_LONG_LONG__
+
+#include "../newlib/libc/tinystdio/ultoa_invert.c"
+
+char *
+ref_ultoa_invert(unsigned long long val, char *str, int base);
+
+char *
+narrow_ultoa_invert(unsigned long long val, char *str, int base);
+
+static char *
+fast_ultoa_invert(unsigned long long val, char *str, int base)
+{
+	return __ultoa_invert(val, str, base);
+}
+
+static const struct {
+	const char	*name;
+	char		*(*conv)(unsigned long long, char *, int);
+} convs[] = {
+	{ "fast", fast_ultoa_invert },
+	{ "narrow", narrow_ultoa_invert },
+	{ "ref", ref_ultoa_invert },
+};
+
+#define NCONV	(sizeof(convs) / sizeof(convs[0]))
+
+static const struct {
+	unsigned long long	val;
+	const char		*dec;
+	const char		*oct;
+	const char		*hex;
+} known[] = {
+	{ 0ULL, "0", "0", "0" },
+	{ 9ULL, "9", "11", "9" },
+	{ 10ULL, "10", "12", "a" },
+	{ 99999999ULL, "99999999", "575360377", "5f5e0ff" },
+	{ 100000000ULL, "100000000", "575360400", "5f5e100" },
+	{ 100000001ULL, "100000001", "575360401", "5f5e101" },
+	{ 4294967295ULL, "4294967295", "37777777777", "ffffffff" },
+	{ 4294967296ULL, "4294967296", "40000000000", "100000000" },
+	{ 9999999999999999ULL, "9999999999999999", "434157115760177777", "2386f26fc0ffff" },
+	{ 10000000000000000ULL, "10000000000000000", "434157115760200000", "2386f26fc10000" },
+	{ 10000000000000001ULL, "10000000000000001", "434157115760200001", "2386f26fc10001" },
+	{ 10000000000000000000ULL, "10000000000000000000", "1053071060221172000000", "8ac7230489e80000" },
+	{ 18446744073709551615ULL, "18446744073709551615", "1777777777777777777777", "ffffffffffffffff" },
+};
+
+#define NKNOWN	(sizeof(known) / sizeof(known[0]))
+
+/* Convert and put the digits back in the usual order */
+static void
+convert(char *(*conv)(unsigned long long, char *, int),
+	unsigned long long val, char *buf, int base)
+{
+	char tmp[24];
+	char *end = conv(val, tmp, base);
+	int len = end - tmp;
+	int i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = tmp[len - 1 - i];
+	buf[len] = '\0';
+}
+
+/* One digit at a time using the compiler's 64-bit divide */
+static void
+simple(unsigned long long val, char *buf, int base)
+{
+	const char *digits = (base & XTOA_UPPER) ? "0123456789ABCDEF" : "0123456789abcdef";
+	unsigned radix = base & ~XTOA_UPPER;
+	char tmp[24];
+	int len = 0, i;
+
+	do {
+		tmp[len++] = digits[val % radix];
+		val /= radix;
+	} while (val);
+	for (i = 0; i < len; i++)
+		buf[i] = tmp[len - 1 - i];
+	buf[len] = '\0';
+}
+
+static int
+check_one(unsigned c, unsigned long long val, int base, const char *want)
+{
+	char got[24];
+
+	convert(convs[c].conv, val, got, base);
+	if (strcmp(got, want) != 0) {
+		printf("%s: base %d value %llu got \"%s\" want \"%s\"\n",
+		       convs[c].name, base, val, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static void
+upcase(char *dst, const char *src)
+{
+	do {
+		*dst = (*src >= 'a' && *src <= 'f') ? *src - 'a' + 'A' : *src;
+		dst++;
+	} while (*src++);
+}
+
+#define NRAND	10000
+
+int
+main(void)
+{
+	static const int bases[] = { 8, 10, 16, 16 | XTOA_UPPER };
+	char want[24];
+	unsigned c, k, b;
+	int i, d, result = 0;
+
+	for (c = 0; c < NCONV; c++) {
+		for (k = 0; k < NKNOWN; k++) {
+			result += check_one(c, known[k].val, 10, known[k].dec);
+			result += check_one(c, known[k].val, 8, known[k].oct);
+			result += check_one(c, known[k].val, 16, known[k].hex);
+			upcase(want, known[k].hex);
+			result += check_one(c, known[k].val, 16 | XTOA_UPPER, want);
+		}
+	}
+
+	/* Random values with evenly distributed digit counts */
+	for (i = 0; i < NRAND; i++) {
+		unsigned long long v = ((unsigned long long) random() << 33) ^
+			((unsigned long long) random() << 11) ^ random();
+
+		for (d = 19; d > i % 20; d--)
+			v /= 10;
+		for (b = 0; b < sizeof(bases) / sizeof(bases[0]); b++) {
+			simple(v, want, bases[b]);
+			for (c = 0; c < NCONV; c++)
+				result += check_one(c, v, bases[b], want);
+		}
+	}
+	return result != 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 agent
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+/*
+ * Check the array math functions against the scalar ones, over a mix
+ * of special values and random arguments long enough to span several
+ * blocks, both out of place and in place.
+ */
+
+#define NVAL	300
+
+static double dx[NVAL], dy[NVAL], dout[NVAL], dout2[NVAL], dbuf[NVAL];
+static float fx[NVAL], fy[NVAL], fout[NVAL], fout2[NVAL], fbuf[NVAL];
+
+static const double dspecial[] = {
+	0.0, -0.0, 1.0, -1.0, 2.0, 0.5, 0.99, 1.01, 0x1.921fb54442d18p+0,
+	0x1p-1074, -0x1p-1074, 0x1p-1022, 0x1p-30, -0x1p-60, DBL_MAX, -DBL_MAX,
+	INFINITY, -INFINITY, NAN, 88.0, -104.0, 700.0, -750.0, 710.0,
+	1e6, 0x1p20, 3e20, 1e300,
+};
+
+#define NSPECIAL (sizeof(dspecial) / sizeof(dspecial[0]))
+
+static uint32_t seed = 1;
+
+static uint32_t
+rnd(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+/* Random value of either sign with exponent in [lo, hi) */
+static double
+rnd_val(int lo, int hi)
+{
+	double v = ldexp(1.0 + (rnd() & 0xffff) / 65536.0, lo + (int) (rnd() % (hi - lo)));
+
+	return (rnd() & 1) ? -v : v;
+}
+
+static void
+fill(void)
+{
+	size_t i;
+
+	for (i = 0; i < NVAL; i++) {
+		if (i % 11 == 0)
+			dx[i] = dspecial[(i / 11) % NSPECIAL];
+		else
+			dx[i] = rnd_val(-30, 12);
+		if (i % 13 == 0)
+			dy[i] = dspecial[(i / 13) % NSPECIAL];
+		else if (i % 5 == 0)
+			dy[i] = (double) (int) rnd_val(0, 7);
+		else
+			dy[i] = rnd_val(-8, 7);
+		fx[i] = (float) dx[i];
+		fy[i] = (float) dy[i];
+	}
+}
+
+static int64_t
+ordered(double x)
+{
+	int64_t i;
+
+	memcpy(&i, &x, sizeof(i));
+	return i < 0 ? INT64_MIN - i : i;
+}
+
+static int32_t
+orderedf(float x)
+{
+	int32_t i;
+
+	memcpy(&i, &x, sizeof(i));
+	return i < 0 ? INT32_MIN - i : i;
+}
+
+static int
+check(const char *name, double x, double got, double want, int ulps)
+{
+	int64_t d = ordered(got) - ordered(want);
+
+	if (isnan(want) ? !isnan(got) : (d > ulps || d < -ulps)) {
+		printf("%s(%.17g) = %.17g, want %.17g\n", name, x, got, want);
+		return 1;
+	}
+	return 0;
+}
+
+static int
+checkf(const char *name, float x, float got, float want)
+{
+	if (isnan(want) ? !isnan(got) : orderedf(got) != orderedf(want)) {
+		printf("%s(%.9g) = %.9g, want %.9g\n", name, (double) x, (double) got, (double) want);
+		return 1;
+	}
+	return 0;
+}
+
+static int
+test_d(const char *name, void (*vf)(double *, const double *, size_t),
+       double (*f)(double), int ulps)
+{
+	size_t i;
+
+	vf(dout, dx, NVAL);
+	memcpy(dbuf, dx, sizeof(dbuf));
+	vf(dbuf, dbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		double want = f(dx[i]);
+		if (check(name, dx[i], dout[i], want, ulps) ||
+		    check(name, dx[i], dbuf[i], want, ulps))
+			return 1;
+	}
+	return 0;
+}
+
+static int
+test_f(const char *name, void (*vf)(float *, const float *, size_t),
+       float (*f)(float))
+{
+	size_t i;
+
+	vf(fout, fx, NVAL);
+	memcpy(fbuf, fx, sizeof(fbuf));
+	vf(fbuf, fbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		float want = f(fx[i]);
+		if (checkf(name, fx[i], fout[i], want) ||
+		    checkf(name, fx[i], fbuf[i], want))
+			return 1;
+	}
+	return 0;
+}
+
+static int
+test_pow(void)
+{
+	size_t i;
+
+	vpow(dout, dx, dy, NVAL);
+	memcpy(dbuf, dy, sizeof(dbuf));
+	vpow(dbuf, dx, dbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		double want = pow(dx[i], dy[i]);
+		if (check("vpow", dx[i], dout[i], want, 0) ||
+		    check("vpow", dx[i], dbuf[i], want, 0))
+			return 1;
+	}
+	vpowf(fout, fx, fy, NVAL);
+	memcpy(fbuf, fy, sizeof(fbuf));
+	vpowf(fbuf, fx, fbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		float want = powf(fx[i], fy[i]);
+		if (checkf("vpowf", fx[i], fout[i], want) ||
+		    checkf("vpowf", fx[i], fbuf[i], want))
+			return 1;
+	}
+	return 0;
+}
+
+static int
+test_sincos(void)
+{
+	size_t i;
+
+	vsincos(dout, dout2, dx, NVAL);
+	memcpy(dbuf, dx, sizeof(dbuf));
+	vsincos(dout, dbuf, dbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		if (check("vsincos", dx[i], dout[i], sin(dx[i]), 1) ||
+		    check("vsincos", dx[i], dout2[i], cos(dx[i]), 0) ||
+		    check("vsincos", dx[i], dbuf[i], cos(dx[i]), 0))
+			return 1;
+	}
+	vsincosf(fout, fout2, fx, NVAL);
+	memcpy(fbuf, fx, sizeof(fbuf));
+	vsincosf(fbuf, fout2, fbuf, NVAL);
+	for (i = 0; i < NVAL; i++) {
+		if (checkf("vsincosf", fx[i], fout[i], sinf(fx[i])) ||
+		    checkf("vsincosf", fx[i], fout2[i], cosf(fx[i])) ||
+		    checkf("vsincosf", fx[i], fbuf[i], sinf(fx[i])))
+			return 1;
+	}
+	return 0;
+}
+
+int
+main(void)
+{
+	int error = 0;
+
+	fill();
+
+	/*
+	 * The vector sin kernel always takes the reduced argument path,
+	 * which can round differently from the short one sin uses below
+	 * pi/4.
+	 */
+	error += test_d("vsin", vsin, sin, 1);
+	error += test_d("vcos", vcos, cos, 0);
+	error += test_d("vexp", vexp, exp, 0);
+	error += test_d("vlog", vlog, log, 0);
+	error += test_f("vsinf", vsinf, sinf);
+	error += test_f("vcosf", vcosf, cosf);
+	error += test_f("vexpf", vexpf, expf);
+	error += test_f("vlogf", vlogf, logf);
+	error += test_pow();
+	error += test_sincos();
+
+	/* A zero length call must not touch the output */
+	dout[0] = 42.0;
+	vexp(dout, dx, 0);
+	if (dout[0] != 42.0) {
+		printf("vexp with n = 0 wrote the output\n");
+		error++;
+	}
+	return error;
+}